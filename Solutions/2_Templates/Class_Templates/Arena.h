@@ -0,0 +1,147 @@
+/**************************************************************************************************
+*
+* \file Arena.h
+* \brief C++ Training - Monotonic arena and the corresponding allocator
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#pragma once
+
+
+//*************************************************************************************************
+// Class definition of the arena
+//*************************************************************************************************
+
+// Monotonic bump-pointer arena. Memory is handed out by advancing a pointer within large blocks
+// and individual deallocations are no-ops. All memory is released at once, either explicitly
+// via 'release()' or by the destructor of the arena.
+class Arena
+{
+ public:
+   explicit Arena( std::size_t blockSize = 65536U )
+      : blockSize_( blockSize )
+   {}
+
+   Arena( Arena const& ) = delete;
+   Arena& operator=( Arena const& ) = delete;
+
+   ~Arena()
+   {
+      release();
+   }
+
+   void* allocate( std::size_t bytes, std::size_t alignment = alignof(std::max_align_t) )
+   {
+      void* ptr = current_;
+      std::size_t space = end_ - current_;
+
+      if( !std::align( alignment, bytes, ptr, space ) ) {
+         addBlock( bytes + alignment );
+         ptr = current_;
+         space = end_ - current_;
+         std::align( alignment, bytes, ptr, space );
+      }
+
+      current_ = static_cast<std::byte*>( ptr ) + bytes;
+      return ptr;
+   }
+
+   void deallocate( void* /*ptr*/, std::size_t /*bytes*/ ) noexcept
+   {}
+
+   // Releases all memory; all objects allocated from the arena must have been destroyed
+   void release() noexcept
+   {
+      while( blocks_ ) {
+         ::operator delete( std::exchange( blocks_, blocks_->next ) );
+      }
+      current_ = nullptr;
+      end_     = nullptr;
+   }
+
+ private:
+   struct Block
+   {
+      Block* next;
+   };
+
+   void addBlock( std::size_t minBytes )
+   {
+      std::size_t const size = std::max( blockSize_, sizeof(Block) + minBytes );
+
+      Block* const block = static_cast<Block*>( ::operator new( size ) );
+      block->next = blocks_;
+      blocks_  = block;
+      current_ = reinterpret_cast<std::byte*>( block + 1 );
+      end_     = reinterpret_cast<std::byte*>( block ) + size;
+   }
+
+   std::size_t blockSize_;
+   Block*      blocks_ { nullptr };
+   std::byte*  current_{ nullptr };
+   std::byte*  end_    { nullptr };
+};
+
+
+
+
+//*************************************************************************************************
+// Class definition of the arena allocator
+//*************************************************************************************************
+
+// Allocator requesting memory from an 'Arena'. The allocator propagates with the container, such
+// that the elements never leave the arena they have been allocated in.
+template< typename T >
+class ArenaAllocator
+{
+ public:
+   using value_type = T;
+
+   using propagate_on_container_copy_assignment = std::true_type;
+   using propagate_on_container_move_assignment = std::true_type;
+   using propagate_on_container_swap            = std::true_type;
+
+   ArenaAllocator( Arena& arena ) noexcept
+      : arena_( &arena )
+   {}
+
+   template< typename U >
+   ArenaAllocator( ArenaAllocator<U> const& other ) noexcept
+      : arena_( other.arena_ )
+   {}
+
+   T* allocate( std::size_t n )
+   {
+      if( n > std::numeric_limits<std::size_t>::max() / sizeof(T) ) {
+         throw std::bad_array_new_length{};
+      }
+      return static_cast<T*>( arena_->allocate( n*sizeof(T), alignof(T) ) );
+   }
+
+   void deallocate( T* ptr, std::size_t n ) noexcept
+   {
+      arena_->deallocate( ptr, n*sizeof(T) );
+   }
+
+   Arena& arena() const noexcept { return *arena_; }
+
+   friend bool operator==( ArenaAllocator const& lhs, ArenaAllocator const& rhs ) = default;
+
+ private:
+   Arena* arena_;
+
+   template< typename U > friend class ArenaAllocator;
+};
@@ -0,0 +1,349 @@
+/**************************************************************************************************
+*
+* \file ChunkView.h
+* \brief C++ Training - Cache- and thread-sized partitioning of spans
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Span.h"
+
+#pragma once
+
+
+//*************************************************************************************************
+// Class definition of chunk_view
+//*************************************************************************************************
+
+// Non-owning view on a span, which is partitioned into consecutive chunks of 'n' elements. All
+// chunks but the last one contain exactly 'n' elements.
+template< typename T >
+class chunk_view
+{
+ public:
+   using value_type = std::span<T>;
+
+   class iterator
+   {
+    public:
+      // Chunks are returned as spans by value, which restricts the legacy category to input
+      using iterator_concept  = std::random_access_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type        = std::span<T>;
+      using difference_type   = std::ptrdiff_t;
+      using reference         = value_type;
+      using pointer           = void;
+
+      iterator() = default;
+      iterator( chunk_view const* view, size_t index ) noexcept : view_( view ), index_( index ) {}
+
+      reference operator*() const noexcept { return (*view_)[index_]; }
+      reference operator[]( difference_type n ) const noexcept { return (*view_)[index_+n]; }
+
+      iterator& operator++() noexcept { ++index_; return *this; }
+      iterator  operator++(int) noexcept { iterator tmp( *this ); ++index_; return tmp; }
+      iterator& operator--() noexcept { --index_; return *this; }
+      iterator  operator--(int) noexcept { iterator tmp( *this ); --index_; return tmp; }
+
+      iterator& operator+=( difference_type n ) noexcept { index_ += n; return *this; }
+      iterator& operator-=( difference_type n ) noexcept { index_ -= n; return *this; }
+
+      friend iterator operator+( iterator it, difference_type n ) noexcept { return it += n; }
+      friend iterator operator+( difference_type n, iterator it ) noexcept { return it += n; }
+      friend iterator operator-( iterator it, difference_type n ) noexcept { return it -= n; }
+
+      friend difference_type operator-( iterator const& a, iterator const& b ) noexcept
+      {
+         return static_cast<difference_type>( a.index_ ) - static_cast<difference_type>( b.index_ );
+      }
+
+      friend bool operator==( iterator const& a, iterator const& b ) noexcept { return a.index_ == b.index_; }
+      friend auto operator<=>( iterator const& a, iterator const& b ) noexcept { return a.index_ <=> b.index_; }
+
+    private:
+      chunk_view const* view_{ nullptr };
+      size_t index_{ 0U };
+   };
+
+   chunk_view( std::span<T> s, size_t n ) noexcept
+      : span_( s )
+      , chunk_( n )
+   {
+      assert( n > 0U );
+   }
+
+   size_t size()       const noexcept { return ( span_.size() + chunk_ - 1U ) / chunk_; }
+   bool   empty()      const noexcept { return span_.empty(); }
+   size_t chunk_size() const noexcept { return chunk_; }
+
+   std::span<T> operator[]( size_t index ) const noexcept
+   {
+      assert( index < size() );
+      size_t const first = index * chunk_;
+      return span_.subspan( first, std::min( chunk_, span_.size()-first ) );
+   }
+
+   iterator begin() const noexcept { return iterator( this, 0U ); }
+   iterator end()   const noexcept { return iterator( this, size() ); }
+
+ private:
+   std::span<T> span_;
+   size_t chunk_;
+};
+
+template< typename T, size_t Extent >
+chunk_view( std::span<T,Extent>, size_t ) -> chunk_view<T>;
+
+
+//*************************************************************************************************
+// Class definition of tile_view
+//*************************************************************************************************
+
+// Partitioning of a span into tiles of (at most) the given number of bytes. Every tile contains
+// at least one element.
+template< typename T >
+class tile_view : public chunk_view<T>
+{
+ public:
+   tile_view( std::span<T> s, size_t bytes_per_tile ) noexcept
+      : chunk_view<T>( s, std::max( bytes_per_tile / sizeof(T), size_t{ 1U } ) )
+   {}
+};
+
+template< typename T, size_t Extent >
+tile_view( std::span<T,Extent>, size_t ) -> tile_view<T>;
+
+
+//*************************************************************************************************
+// Detection of the cache sizes
+//*************************************************************************************************
+
+struct cache_info
+{
+   size_t l1d_size { 32U * 1024U };
+   size_t l2_size  { 1024U * 1024U };
+   size_t line_size{ 64U };
+};
+
+namespace detail {
+
+// Reads a cache size of the form "48K" from '/sys/devices/system/cpu/cpu0/cache/index<I>/size'
+// for the given cache level and type; returns 0 if there is no such cache
+inline size_t read_sysfs_cache_size( unsigned level, std::string const& type )
+{
+   for( unsigned index=0U; index<8U; ++index )
+   {
+      std::string const dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string( index ) + "/";
+
+      unsigned l( 0U );
+      std::string t, size;
+      if( !( std::ifstream( dir + "level" ) >> l ) ) break;
+      if( l != level || !( std::ifstream( dir + "type" ) >> t ) || t != type ) continue;
+      if( !( std::ifstream( dir + "size" ) >> size ) || size.empty() ) continue;
+
+      size_t value( std::stoul( size ) );
+      switch( size.back() ) {
+         case 'K': value <<= 10U; break;
+         case 'M': value <<= 20U; break;
+         default: break;
+      }
+      return value;
+   }
+   return 0U;
+}
+
+inline cache_info detect_cache_info()
+{
+   cache_info info{};
+
+   auto const positive = []( long value ) -> size_t {
+      return value > 0 ? static_cast<size_t>( value ) : 0U;
+   };
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+   size_t const l1d  = positive( ::sysconf( _SC_LEVEL1_DCACHE_SIZE ) );
+   size_t const l2   = positive( ::sysconf( _SC_LEVEL2_CACHE_SIZE ) );
+   size_t const line = positive( ::sysconf( _SC_LEVEL1_DCACHE_LINESIZE ) );
+#else
+   size_t const l1d( 0U ), l2( 0U ), line( positive( 0L ) );
+#endif
+
+   // Fallback to sysfs, e.g. on platforms where 'sysconf()' reports 0
+   if( size_t const size = l1d ? l1d : read_sysfs_cache_size( 1U, "Data" ) ) info.l1d_size = size;
+   if( size_t const size = l2 ? l2 : read_sysfs_cache_size( 2U, "Unified" ) ) info.l2_size = size;
+   if( line ) info.line_size = line;
+
+   return info;
+}
+
+} // namespace detail
+
+// The cache sizes of the first CPU, detected once
+inline cache_info const& detected_cache_info()
+{
+   static cache_info const info = detail::detect_cache_info();
+   return info;
+}
+
+
+//*************************************************************************************************
+// Class definition of thread_pool
+//*************************************************************************************************
+
+// Fixed set of worker threads for bulk jobs: 'run( job )' executes 'job()' once on every worker
+// and on the calling thread and returns when all calls have finished. The job must not throw and
+// must not call 'run()' on the same pool.
+class thread_pool
+{
+ public:
+   explicit thread_pool( size_t threads = std::max( std::thread::hardware_concurrency(), 1U ) )
+   {
+      threads = std::max( threads, size_t{ 1U } );  // The calling thread always takes part
+      workers_.reserve( threads-1U );
+      for( size_t i=1U; i<threads; ++i ) {
+         workers_.emplace_back( [this]( std::stop_token stop ){ work( stop ); } );
+      }
+   }
+
+   thread_pool( thread_pool const& ) = delete;
+   thread_pool& operator=( thread_pool const& ) = delete;
+
+   ~thread_pool()
+   {
+      for( std::jthread& worker : workers_ ) worker.request_stop();
+      workers_.clear();
+   }
+
+   // Number of threads, including the calling thread
+   size_t size() const noexcept { return workers_.size() + 1U; }
+
+   template< typename Job >
+   void run( Job& job )
+   {
+      std::scoped_lock const serialize( run_mutex_ );
+
+      {
+         std::scoped_lock const lock( mutex_ );
+         job_    = &job;
+         call_   = []( void* j ){ (*static_cast<Job*>( j ))(); };
+         active_ = workers_.size();
+         ++generation_;
+      }
+      start_.notify_all();
+
+      job();
+
+      std::unique_lock lock( mutex_ );
+      done_.wait( lock, [this]{ return active_ == 0U; } );
+   }
+
+ private:
+   void work( std::stop_token stop )
+   {
+      size_t seen( 0U );
+
+      while( true )
+      {
+         std::unique_lock lock( mutex_ );
+         if( !start_.wait( lock, stop, [&]{ return generation_ != seen; } ) ) return;
+         seen = generation_;
+         void* const job  = job_;
+         void (*call)(void*) = call_;
+         lock.unlock();
+
+         call( job );
+
+         lock.lock();
+         if( --active_ == 0U ) done_.notify_one();
+      }
+   }
+
+   std::mutex run_mutex_{};
+   std::mutex mutex_{};
+   std::condition_variable_any start_{};
+   std::condition_variable done_{};
+   void* job_{ nullptr };
+   void (*call_)(void*){ nullptr };
+   size_t active_{ 0U };
+   size_t generation_{ 0U };
+   std::vector<std::jthread> workers_{};  // Declared last to be destroyed first
+};
+
+inline thread_pool& default_thread_pool()
+{
+   static thread_pool pool{};
+   return pool;
+}
+
+
+//*************************************************************************************************
+// parallel_for_each_chunk
+//*************************************************************************************************
+
+// Default number of bytes per chunk: half of the L2 cache, such that the chunk and the data
+// derived from it stay in cache between consecutive passes over the chunk
+inline size_t default_chunk_bytes()
+{
+   cache_info const& info = detected_cache_info();
+   return std::max( info.l2_size / 2U / info.line_size * info.line_size, info.line_size );
+}
+
+// Calls 'fn( chunk )' for every chunk of the given span on the threads of the given pool. The
+// chunks are claimed one after another, i.e. the load is balanced dynamically. 'bytes_per_chunk'
+// defaults to 'default_chunk_bytes()'. An exception thrown by 'fn' stops the processing (at chunk
+// granularity) and is rethrown. Note that 'fn' is called concurrently.
+template< typename T, size_t Extent, typename Fn >
+void parallel_for_each_chunk( std::span<T,Extent> s, Fn fn, size_t bytes_per_chunk = 0U
+                            , thread_pool& pool = default_thread_pool() )
+{
+   tile_view<T> const tiles( std::span<T>( s ), bytes_per_chunk ? bytes_per_chunk : default_chunk_bytes() );
+   size_t const count = tiles.size();
+
+   if( count <= 1U || pool.size() == 1U ) {
+      for( std::span<T> chunk : tiles ) fn( chunk );
+      return;
+   }
+
+   std::atomic<size_t> next{ 0U };
+   std::atomic<bool> cancelled{ false };
+   std::exception_ptr exception{};
+   std::mutex mutex{};
+
+   auto work = [&]() noexcept
+   {
+      try {
+         for( size_t index=next++; index<count && !cancelled.load( std::memory_order_relaxed ); index=next++ ) {
+            fn( tiles[index] );
+         }
+      }
+      catch( ... ) {
+         std::scoped_lock const lock( mutex );
+         if( !exception ) exception = std::current_exception();
+         cancelled = true;
+      }
+   };
+
+   pool.run( work );
+
+   if( exception ) std::rethrow_exception( exception );
+}
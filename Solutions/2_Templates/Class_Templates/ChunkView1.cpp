@@ -0,0 +1,152 @@
+/**************************************************************************************************
+*
+* \file ChunkView1.cpp
+* \brief C++ Training - Class Design Example
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Implement the views 'chunk_view' and 'tile_view', which partition a span into chunks of a
+*       given number of elements or bytes, respectively:
+*
+*         for( std::span<float> chunk : chunk_view( s, 1000 ) ) { ... }
+*         for( std::span<float> tile  : tile_view( s, 32768 ) ) { ... }
+*
+*       In addition, implement the 'parallel_for_each_chunk()' function, which processes cache
+*       sized chunks of a span on a thread pool.
+*
+**************************************************************************************************/
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "ChunkView.h"
+
+
+// Three passes of a streaming transformation. Every pass reads and writes the entire span, i.e.
+// for large spans every pass streams the data from and to main memory.
+void transform( std::span<float> s )
+{
+   for( float& x : s ) x = 0.5F * x + 1.0F;
+   for( float& x : s ) x = std::sqrt( x );
+   for( float& x : s ) x = x * x - 1.0F;
+}
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
+int main()
+{
+   // Partitioning of a span into chunks and tiles
+   {
+      std::vector<int> v( 10U );
+      std::iota( v.begin(), v.end(), 0 );
+
+      chunk_view const chunks( std::span<int>( v ), 4U );
+      assert( chunks.size() == 3U && chunks[2].size() == 2U && chunks[2][1] == 9 );
+      assert( chunks.end() - chunks.begin() == 3 );
+
+      std::cout << "\n Chunks of 4:";
+      for( std::span<int> chunk : chunks ) {
+         std::cout << " [";
+         for( int i : chunk ) std::cout << ' ' << i;
+         std::cout << " ]";
+      }
+      std::cout << "\n";
+
+      tile_view const tiles( std::span<int const>( v ), 3U*sizeof(int) + 1U );
+      assert( tiles.chunk_size() == 3U && tiles.size() == 4U && tiles[3].front() == 9 );
+
+      // Explicit pool with four threads, independent of the number of cores
+      thread_pool pool( 4U );
+      assert( pool.size() == 4U );
+
+      parallel_for_each_chunk( std::span<int>( v ), []( std::span<int> chunk ){
+         for( int& i : chunk ) i *= 2;
+      }, 2U*sizeof(int), pool );
+      assert( std::accumulate( v.begin(), v.end(), 0 ) == 90 );
+
+      try {
+         parallel_for_each_chunk( std::span<int>( v ), []( std::span<int> chunk ){
+            if( chunk.front() == 8 ) throw std::runtime_error( "Chunk failed" );
+         }, sizeof(int), pool );
+         assert( false );
+      }
+      catch( std::runtime_error const& ex ) {
+         std::cout << " Expected error: " << ex.what() << "\n";
+      }
+   }
+
+   // Comparison of the streaming transformation on the entire span and chunk by chunk
+   {
+      constexpr size_t N( size_t{32} << 20U );  // 128 MiB
+      constexpr size_t repetitions( 3U );
+
+      cache_info const& info = detected_cache_info();
+      size_t const chunk_bytes = default_chunk_bytes();
+
+      std::vector<float> v( N );
+      std::span<float> const s( v );
+      double checksum( 0.0 );
+
+      auto const run = [&]( auto op ) {
+         double time( 0.0 );
+         for( size_t rep=0U; rep<repetitions; ++rep ) {
+            std::iota( v.begin(), v.end(), 0.0F );
+            time += measure( op );
+         }
+         checksum = std::accumulate( v.begin(), v.begin()+1000, 0.0 );
+         return time / repetitions;
+      };
+
+      double const t1 = run( [&]{ transform( s ); } );
+      double const expected( checksum );
+
+      double const t2 = run( [&]{
+         for( std::span<float> tile : tile_view( s, chunk_bytes ) ) transform( tile );
+      } );
+      bool consistent( checksum == expected );
+
+      double const t3 = run( [&]{
+         for( std::span<float> tile : tile_view( s, info.l1d_size / 2U ) ) transform( tile );
+      } );
+      consistent &= ( checksum == expected );
+
+      double const t4 = run( [&]{ parallel_for_each_chunk( s, transform ); } );
+      consistent &= ( checksum == expected );
+
+      double const megabytes = N * sizeof(float) / 1048576.0;
+
+      std::cout << "\n L1d cache: " << ( info.l1d_size >> 10U ) << " KiB, L2 cache: " << ( info.l2_size >> 10U )
+                << " KiB, chunk size: " << ( chunk_bytes >> 10U ) << " KiB, threads: " << default_thread_pool().size() << "\n"
+                << " Streaming transform (3 passes, " << megabytes << " MiB)      Time\n"
+                << " naive loop over the entire span              " << std::setw(9) << t1 << " ms\n"
+                << " tile_view, L2-sized tiles                    " << std::setw(9) << t2 << " ms\n"
+                << " tile_view, L1-sized tiles                    " << std::setw(9) << t3 << " ms\n"
+                << " parallel_for_each_chunk                      " << std::setw(9) << t4 << " ms\n"
+                << " Results consistent: " << std::boolalpha << consistent << "\n\n";
+      assert( consistent );
+   }
+
+   return EXIT_SUCCESS;
+}
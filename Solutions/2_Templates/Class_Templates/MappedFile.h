@@ -0,0 +1,248 @@
+/**************************************************************************************************
+*
+* \file MappedFile.h
+* \brief C++ Training - RAII wrapper for memory-mapped files (POSIX)
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Span.h"
+
+#pragma once
+
+
+//*************************************************************************************************
+// Class definition of the mapped file
+//*************************************************************************************************
+
+// Read-only or read-write memory mapping of a file. The mapping either covers the entire file or
+// a sliding window of a fixed size, which allows to process files exceeding the address space
+// budget window by window. The mapped bytes are exposed via 'span'. All failures to open or map
+// the file are reported via 'std::system_error'.
+class mapped_file
+{
+ public:
+   enum class mode { read_only, read_write };
+
+   enum class advice { normal, sequential, random, willneed, dontneed, hugepage };
+
+   static constexpr size_t whole_file = 0U;
+
+   mapped_file() = default;
+
+   // Maps the given file; a 'window' different from 'whole_file' limits the mapping to the given
+   // number of bytes starting at the beginning of the file
+   explicit mapped_file( std::string const& path, mode m = mode::read_only, size_t window = whole_file )
+      : mode_( m )
+   {
+      fd_ = ::open( path.c_str(), ( m == mode::read_only ? O_RDONLY : O_RDWR ) | O_CLOEXEC );
+      if( fd_ < 0 ) {
+         throw std::system_error( errno, std::generic_category(), "open '" + path + "'" );
+      }
+
+      struct stat info{};
+      if( ::fstat( fd_, &info ) != 0 ) {
+         int const error( errno );
+         ::close( fd_ );
+         throw std::system_error( error, std::generic_category(), "fstat '" + path + "'" );
+      }
+
+      file_size_ = static_cast<size_t>( info.st_size );
+      window_    = ( window == whole_file ? file_size_ : window );
+
+      try {
+         map_window( 0U );
+      }
+      catch( ... ) {
+         ::close( fd_ );
+         throw;
+      }
+   }
+
+   mapped_file( mapped_file const& ) = delete;
+   mapped_file& operator=( mapped_file const& ) = delete;
+
+   mapped_file( mapped_file&& other ) noexcept
+      : fd_       ( std::exchange( other.fd_, -1 ) )
+      , mode_     ( other.mode_ )
+      , file_size_( std::exchange( other.file_size_, 0U ) )
+      , window_   ( std::exchange( other.window_, 0U ) )
+      , base_     ( std::exchange( other.base_, nullptr ) )
+      , length_   ( std::exchange( other.length_, 0U ) )
+      , offset_   ( std::exchange( other.offset_, 0U ) )
+      , size_     ( std::exchange( other.size_, 0U ) )
+   {}
+
+   mapped_file& operator=( mapped_file&& other ) noexcept
+   {
+      mapped_file tmp( std::move( other ) );
+      swap( tmp );
+      return *this;
+   }
+
+   ~mapped_file()
+   {
+      unmap();
+      if( fd_ >= 0 ) ::close( fd_ );
+   }
+
+   void swap( mapped_file& other ) noexcept
+   {
+      std::swap( fd_,        other.fd_ );
+      std::swap( mode_,      other.mode_ );
+      std::swap( file_size_, other.file_size_ );
+      std::swap( window_,    other.window_ );
+      std::swap( base_,      other.base_ );
+      std::swap( length_,    other.length_ );
+      std::swap( offset_,    other.offset_ );
+      std::swap( size_,      other.size_ );
+   }
+
+   bool   is_open()       const noexcept { return fd_ >= 0; }
+   size_t file_size()     const noexcept { return file_size_; }
+   size_t window_offset() const noexcept { return offset_; }
+   size_t window_size()   const noexcept { return size_; }
+
+   // Returns whether the current window reaches the end of the file
+   bool is_last_window() const noexcept { return offset_ + size_ >= file_size_; }
+
+   // The bytes of the current window
+   std::span<std::byte const> bytes() const noexcept
+   {
+      return std::span<std::byte const>( data(), size_ );
+   }
+
+   std::span<std::byte> writable_bytes() noexcept
+   {
+      assert( mode_ == mode::read_write );
+      return std::span<std::byte>( data(), size_ );
+   }
+
+   // The current window as elements of type 'T'; the window offset has to be a multiple of the
+   // alignment of 'T' and trailing bytes, which do not form an entire element, are ignored
+   template< typename T >
+   std::span<T const> as() const noexcept
+   {
+      static_assert( std::is_trivially_copyable_v<T>, "Mapped elements must be trivially copyable" );
+      assert( reinterpret_cast<std::uintptr_t>( data() ) % alignof(T) == 0U );
+      return std::span<T const>( reinterpret_cast<T const*>( data() ), size_ / sizeof(T) );
+   }
+
+   // Moves the window to the given file offset. The mapping starts at the preceding page boundary,
+   // but the window starts exactly at 'offset'. In case the new window cannot be mapped, the
+   // current window remains valid (strong exception guarantee).
+   void map_window( size_t offset )
+   {
+      assert( offset <= file_size_ );
+
+      size_t const page    = page_size();
+      size_t const aligned = offset - offset % page;
+      size_t const size    = std::min( window_, file_size_ - offset );
+      size_t const length  = size + ( offset - aligned );
+
+      std::byte* base{ nullptr };
+
+      if( length > 0U ) {
+         int const protection = ( mode_ == mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE );
+         void* const ptr = ::mmap( nullptr, length, protection, MAP_SHARED, fd_, static_cast<off_t>( aligned ) );
+         if( ptr == MAP_FAILED ) {
+            throw std::system_error( errno, std::generic_category(), "mmap" );
+         }
+         base = static_cast<std::byte*>( ptr );
+      }
+
+      unmap();
+
+      base_   = base;
+      length_ = ( base ? length : 0U );
+      offset_ = offset;
+      size_   = size;
+   }
+
+   // Moves the window to the subsequent part of the file; returns 'false' at the end of the file
+   bool next_window()
+   {
+      if( is_last_window() ) return false;
+      map_window( offset_ + size_ );
+      return true;
+   }
+
+   // Gives the kernel a hint about the expected access pattern of the current window. Returns
+   // whether the hint has been accepted (e.g. huge pages are not supported for all file systems).
+   bool advise( advice a ) const noexcept
+   {
+      if( base_ == nullptr ) return true;
+      return ::madvise( base_, length_, to_native( a ) ) == 0;
+   }
+
+   // Writes modifications of the current window back to the file
+   void flush() const
+   {
+      if( base_ != nullptr && mode_ == mode::read_write && ::msync( base_, length_, MS_SYNC ) != 0 ) {
+         throw std::system_error( errno, std::generic_category(), "msync" );
+      }
+   }
+
+   static size_t page_size() noexcept
+   {
+      static size_t const size = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+      return size;
+   }
+
+ private:
+   std::byte* data() const noexcept
+   {
+      return base_ == nullptr ? nullptr : base_ + ( length_ - size_ );
+   }
+
+   void unmap() noexcept
+   {
+      if( base_ != nullptr ) {
+         ::munmap( base_, length_ );
+         base_   = nullptr;
+         length_ = 0U;
+      }
+   }
+
+   static int to_native( advice a ) noexcept
+   {
+      switch( a ) {
+         case advice::sequential: return MADV_SEQUENTIAL;
+         case advice::random:     return MADV_RANDOM;
+         case advice::willneed:   return MADV_WILLNEED;
+         case advice::dontneed:   return MADV_DONTNEED;
+#ifdef MADV_HUGEPAGE
+         case advice::hugepage:   return MADV_HUGEPAGE;
+#endif
+         default:                 return MADV_NORMAL;
+      }
+   }
+
+   int        fd_       { -1 };
+   mode       mode_     { mode::read_only };
+   size_t     file_size_{ 0U };
+   size_t     window_   { 0U };  // Maximum number of bytes per window
+   std::byte* base_     { nullptr };
+   size_t     length_   { 0U };  // Number of mapped bytes, starting at a page boundary
+   size_t     offset_   { 0U };  // File offset of the current window
+   size_t     size_     { 0U };  // Number of bytes in the current window
+};
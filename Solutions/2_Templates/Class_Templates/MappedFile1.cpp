@@ -0,0 +1,206 @@
+/**************************************************************************************************
+*
+* \file MappedFile1.cpp
+* \brief C++ Training - Class Design Example
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Implement the class 'mapped_file', a RAII wrapper for a memory-mapped file, which exposes
+*       the content of the file via 'span' instead of copying it into a buffer first:
+*
+*         mapped_file file( "data.bin" );             // Read-only mapping of the entire file
+*         std::span<std::byte const> s = file.bytes();
+*         std::span<uint64_t const>  v = file.as<uint64_t>();
+*
+*       The mapping should support 'madvise()' hints and sliding windows for files, which are too
+*       large to be mapped at once.
+*
+**************************************************************************************************/
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "MappedFile.h"
+
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+// Creates a file of 'count' consecutive 64-bit integers
+void create_file( std::string const& path, size_t count )
+{
+   std::ofstream out( path, std::ios::binary | std::ios::trunc );
+   std::vector<uint64_t> buffer( 1U << 17U );
+
+   for( size_t i=0U; i<count; i+=buffer.size() ) {
+      size_t const n = std::min( buffer.size(), count-i );
+      std::iota( buffer.begin(), buffer.begin()+n, uint64_t{i} );
+      out.write( reinterpret_cast<char const*>( buffer.data() ), static_cast<std::streamsize>( n*sizeof(uint64_t) ) );
+   }
+}
+
+uint64_t sum( std::span<uint64_t const> values )
+{
+   return std::accumulate( values.begin(), values.end(), uint64_t{0} );
+}
+
+
+int main()
+{
+   std::string const path = ( std::filesystem::temp_directory_path() / "mapped_file_demo.bin" ).string();
+
+   // Basic usage: read-only and read-write mappings, windows with unaligned offsets
+   {
+      create_file( path, 1000U );
+
+      {
+         mapped_file file( path );
+         assert( file.file_size() == 8000U && file.bytes().size() == 8000U );
+         assert( file.as<uint64_t>()[999] == 999U );
+         assert( sum( file.as<uint64_t>() ) == 999U*1000U/2U );
+         assert( file.advise( mapped_file::advice::sequential ) );
+      }
+
+      {
+         mapped_file file( path, mapped_file::mode::read_write );
+         std::span<std::byte> bytes = file.writable_bytes();
+         uint64_t const value( 42U );
+         std::memcpy( bytes.data() + 8U*500U, &value, sizeof(value) );
+         file.flush();
+      }
+
+      {
+         // Windows of 1000 bytes, i.e. every window starts in the middle of a page
+         mapped_file file( path, mapped_file::mode::read_only, 1000U );
+         size_t windows( 0U );
+         uint64_t total( 0U );
+         do {
+            assert( file.window_size() <= 1000U );
+            total += sum( file.as<uint64_t>() );
+            ++windows;
+         } while( file.next_window() );
+         assert( windows == 8U && total == 999U*1000U/2U - 500U + 42U );
+
+         file.map_window( 4000U );
+         assert( file.as<uint64_t>().front() == 42U );
+      }
+
+      mapped_file moved{ mapped_file( path ) };
+      mapped_file other;
+      other = std::move( moved );
+      assert( !moved.is_open() && other.is_open() && other.bytes().size() == 8000U );
+
+      try {
+         mapped_file missing( path + ".missing" );
+         assert( false );
+      }
+      catch( std::system_error const& ex ) {
+         std::cout << "\n Expected error: " << ex.what() << "\n";
+      }
+   }
+
+   // Comparison of mmap and ifstream::read
+   {
+      constexpr size_t count( size_t{32} << 20U );  // 256 MiB
+      constexpr size_t lookups( 1U << 20U );
+      constexpr uint64_t expected( count*(count-1U)/2U );
+      bool consistent( true );
+
+      create_file( path, count );
+
+      std::mt19937_64 rng( 42U );
+      std::uniform_int_distribution<size_t> dist( 0U, count-1U );
+      std::vector<size_t> indices( lookups );
+      for( size_t& i : indices ) i = dist( rng );
+
+      uint64_t result( 0U );
+      double const stream_seq = measure( [&]{
+         std::ifstream in( path, std::ios::binary );
+         std::vector<uint64_t> buffer( 1U << 17U );  // 1 MiB
+         result = 0U;
+         while( in.read( reinterpret_cast<char*>( buffer.data() ), static_cast<std::streamsize>( buffer.size()*sizeof(uint64_t) ) ) || in.gcount() > 0 ) {
+            result += sum( std::span<uint64_t const>( buffer.data(), static_cast<size_t>( in.gcount() )/sizeof(uint64_t) ) );
+         }
+      } );
+      consistent &= ( result == expected );
+
+      double const mmap_seq = measure( [&]{
+         mapped_file file( path );
+         file.advise( mapped_file::advice::sequential );
+         result = sum( file.as<uint64_t>() );
+      } );
+      consistent &= ( result == expected );
+
+      double const mmap_window = measure( [&]{
+         mapped_file file( path, mapped_file::mode::read_only, size_t{64} << 20U );
+         result = 0U;
+         do {
+            file.advise( mapped_file::advice::willneed );
+            result += sum( file.as<uint64_t>() );
+         } while( file.next_window() );
+      } );
+      consistent &= ( result == expected );
+
+      double const stream_rand = measure( [&]{
+         std::ifstream in( path, std::ios::binary );
+         result = 0U;
+         for( size_t i : indices ) {
+            uint64_t value{};
+            in.seekg( static_cast<std::streamoff>( i*sizeof(uint64_t) ) );
+            in.read( reinterpret_cast<char*>( &value ), sizeof(value) );
+            result += value;
+         }
+      } );
+      uint64_t const checksum( result );
+
+      double const mmap_rand = measure( [&]{
+         mapped_file file( path );
+         file.advise( mapped_file::advice::random );
+         std::span<uint64_t const> const values = file.as<uint64_t>();
+         result = 0U;
+         for( size_t i : indices ) {
+            result += values[i];
+         }
+      } );
+      consistent &= ( result == checksum );
+
+      std::cout << "\n File size: " << ( count*sizeof(uint64_t) >> 20U ) << " MiB (warm page cache)\n"
+                << " Sequential sum                       Time\n"
+                << " ifstream::read (1 MiB buffer)  " << std::setw(9) << stream_seq  << " ms\n"
+                << " mmap, entire file              " << std::setw(9) << mmap_seq    << " ms\n"
+                << " mmap, 64 MiB windows           " << std::setw(9) << mmap_window << " ms\n"
+                << " Random 8-byte reads (" << lookups << ")\n"
+                << " ifstream seekg+read            " << std::setw(9) << stream_rand << " ms\n"
+                << " mmap                           " << std::setw(9) << mmap_rand   << " ms\n"
+                << " Results consistent: " << std::boolalpha << consistent << "\n\n";
+      assert( consistent );
+   }
+
+   std::remove( path.c_str() );
+
+   return EXIT_SUCCESS;
+}
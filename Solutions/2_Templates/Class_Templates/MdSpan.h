@@ -0,0 +1,427 @@
+/**************************************************************************************************
+*
+* \file MdSpan.h
+* \brief C++ Training - Simplified multi-dimensional span in the style of C++23 std::mdspan
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Span.h"
+
+#pragma once
+
+
+//*************************************************************************************************
+// Class definition of the extents
+//*************************************************************************************************
+
+namespace detail {
+
+// Storage of 'N' dynamic extents; without any dynamic extent the storage is an empty class
+template< size_t N >
+struct dynamic_storage
+{
+   using type = std::array<size_t,N>;
+};
+
+template<>
+struct dynamic_storage<0U>
+{
+   struct type
+   {
+      constexpr type() noexcept = default;
+      constexpr type( std::array<size_t,0U> const& ) noexcept {}
+      constexpr size_t operator[]( size_t ) const noexcept { return 0U; }
+      friend constexpr bool operator==( type, type ) noexcept = default;
+   };
+};
+
+} // namespace detail
+
+
+// Extents of a multi-dimensional index space. Every extent is either a compile time constant or
+// 'std::dynamic_extent', in which case it is stored at runtime. Index computations based on
+// static extents fold to constants.
+template< size_t... Extents >
+class extents
+{
+ public:
+   static constexpr size_t rank() noexcept { return sizeof...(Extents); }
+
+   static constexpr size_t rank_dynamic() noexcept
+   {
+      return ( size_t{ Extents == std::dynamic_extent } + ... + 0U );
+   }
+
+   static constexpr size_t static_extent( size_t r ) noexcept
+   {
+      constexpr size_t values[] = { Extents..., 0U };
+      return values[r];
+   }
+
+   constexpr extents() noexcept = default;
+
+   // Initialization of the dynamic extents
+   template< typename... Ints >
+      requires( sizeof...(Ints) == rank_dynamic() && ( std::is_convertible_v<Ints,size_t> && ... ) )
+   constexpr explicit extents( Ints... dynamic ) noexcept
+      : dynamic_{ static_cast<size_t>( dynamic )... }
+   {}
+
+   constexpr explicit extents( std::array<size_t,rank_dynamic()> const& dynamic ) noexcept
+      : dynamic_( dynamic )
+   {}
+
+   constexpr size_t extent( size_t r ) const noexcept
+   {
+      assert( r < rank() );
+      if( static_extent( r ) != std::dynamic_extent ) return static_extent( r );
+      return dynamic_[dynamic_index( r )];
+   }
+
+   // Product of all extents
+   constexpr size_t size() const noexcept
+   {
+      size_t product( 1U );
+      for( size_t r=0U; r<rank(); ++r ) {
+         product *= extent( r );
+      }
+      return product;
+   }
+
+   friend constexpr bool operator==( extents const& lhs, extents const& rhs ) noexcept = default;
+
+ private:
+   // Position of the extent 'r' among the dynamic extents
+   static constexpr size_t dynamic_index( size_t r ) noexcept
+   {
+      size_t index{};
+      for( size_t i=0U; i<r; ++i ) {
+         if( static_extent( i ) == std::dynamic_extent ) ++index;
+      }
+      return index;
+   }
+
+   [[no_unique_address]] typename detail::dynamic_storage<rank_dynamic()>::type dynamic_{};
+};
+
+
+namespace detail {
+
+template< size_t Rank, typename Indices = std::make_index_sequence<Rank> >
+struct dextents;
+
+template< size_t Rank, size_t... Is >
+struct dextents< Rank, std::index_sequence<Is...> >
+{
+   using type = extents< ( static_cast<void>( Is ), std::dynamic_extent )... >;
+};
+
+} // namespace detail
+
+// Extents of the given rank with only dynamic extents
+template< size_t Rank >
+using dextents = typename detail::dextents<Rank>::type;
+
+
+
+
+//*************************************************************************************************
+// Class definitions of the layout policies
+//*************************************************************************************************
+
+// Row-major layout (C order): The last index varies fastest
+struct layout_right
+{
+   template< typename Extents >
+   class mapping
+   {
+    public:
+      using extents_type = Extents;
+
+      constexpr mapping() noexcept = default;
+      constexpr explicit mapping( Extents const& e ) noexcept : extents_( e ) {}
+
+      constexpr Extents const& extents() const noexcept { return extents_; }
+
+      template< typename... Indices >
+      constexpr size_t operator()( Indices... indices ) const noexcept
+      {
+         static_assert( sizeof...(Indices) == Extents::rank(), "Invalid number of indices" );
+
+         size_t r{}, offset{};
+         ( ( assert( static_cast<size_t>( indices ) < extents_.extent( r ) ),
+             offset = offset * extents_.extent( r++ ) + static_cast<size_t>( indices ) ), ... );
+         return offset;
+      }
+
+      constexpr size_t stride( size_t r ) const noexcept
+      {
+         size_t stride( 1U );
+         for( size_t i=r+1U; i<Extents::rank(); ++i ) {
+            stride *= extents_.extent( i );
+         }
+         return stride;
+      }
+
+      constexpr size_t required_span_size() const noexcept { return extents_.size(); }
+
+      static constexpr bool is_always_exhaustive() noexcept { return true; }
+
+    private:
+      [[no_unique_address]] Extents extents_{};
+   };
+};
+
+
+// Column-major layout (Fortran order): The first index varies fastest
+struct layout_left
+{
+   template< typename Extents >
+   class mapping
+   {
+    public:
+      using extents_type = Extents;
+
+      constexpr mapping() noexcept = default;
+      constexpr explicit mapping( Extents const& e ) noexcept : extents_( e ) {}
+
+      constexpr Extents const& extents() const noexcept { return extents_; }
+
+      template< typename... Indices >
+      constexpr size_t operator()( Indices... indices ) const noexcept
+      {
+         static_assert( sizeof...(Indices) == Extents::rank(), "Invalid number of indices" );
+
+         size_t const values[] = { static_cast<size_t>( indices )..., 0U };
+         size_t offset{};
+         for( size_t r=Extents::rank(); r>0U; --r ) {
+            assert( values[r-1U] < extents_.extent( r-1U ) );
+            offset = offset * extents_.extent( r-1U ) + values[r-1U];
+         }
+         return offset;
+      }
+
+      constexpr size_t stride( size_t r ) const noexcept
+      {
+         size_t stride( 1U );
+         for( size_t i=0U; i<r; ++i ) {
+            stride *= extents_.extent( i );
+         }
+         return stride;
+      }
+
+      constexpr size_t required_span_size() const noexcept { return extents_.size(); }
+
+      static constexpr bool is_always_exhaustive() noexcept { return true; }
+
+    private:
+      [[no_unique_address]] Extents extents_{};
+   };
+};
+
+
+// Layout with an arbitrary stride per dimension (e.g. for slices of other layouts)
+struct layout_stride
+{
+   template< typename Extents >
+   class mapping
+   {
+    public:
+      using extents_type = Extents;
+
+      constexpr mapping() noexcept = default;
+
+      constexpr mapping( Extents const& e, std::array<size_t,Extents::rank()> const& strides ) noexcept
+         : extents_( e )
+         , strides_( strides )
+      {}
+
+      // Conversion from any other strided mapping with the same extents
+      template< typename Mapping >
+         requires( std::is_same_v< typename Mapping::extents_type, Extents > )
+      constexpr explicit mapping( Mapping const& other ) noexcept
+         : extents_( other.extents() )
+      {
+         for( size_t r=0U; r<Extents::rank(); ++r ) {
+            strides_[r] = other.stride( r );
+         }
+      }
+
+      constexpr Extents const& extents() const noexcept { return extents_; }
+
+      template< typename... Indices >
+      constexpr size_t operator()( Indices... indices ) const noexcept
+      {
+         static_assert( sizeof...(Indices) == Extents::rank(), "Invalid number of indices" );
+
+         size_t r{}, offset{};
+         ( ( assert( static_cast<size_t>( indices ) < extents_.extent( r ) ),
+             offset += static_cast<size_t>( indices ) * strides_[r++] ), ... );
+         return offset;
+      }
+
+      constexpr size_t stride( size_t r ) const noexcept { return strides_[r]; }
+
+      constexpr size_t required_span_size() const noexcept
+      {
+         size_t size( 1U );
+         for( size_t r=0U; r<Extents::rank(); ++r ) {
+            if( extents_.extent( r ) == 0U ) return 0U;
+            size += ( extents_.extent( r ) - 1U ) * strides_[r];
+         }
+         return size;
+      }
+
+      static constexpr bool is_always_exhaustive() noexcept { return false; }
+
+    private:
+      [[no_unique_address]] Extents extents_{};
+      std::array<size_t,Extents::rank()> strides_{};
+   };
+};
+
+
+
+
+//*************************************************************************************************
+// Class definition of the multi-dimensional span
+//*************************************************************************************************
+
+// Non-owning view on a multi-dimensional array. The elements are accessed via 'operator()',
+// which maps the given indices to an offset by means of the layout policy.
+template< typename T, typename Extents, typename Layout = layout_right >
+class mdspan
+{
+ public:
+   using element_type = T;
+   using value_type   = std::remove_cv_t<T>;
+   using extents_type = Extents;
+   using layout_type  = Layout;
+   using mapping_type = typename Layout::template mapping<Extents>;
+   using pointer      = T*;
+   using reference    = T&;
+
+   static constexpr size_t rank()         noexcept { return Extents::rank(); }
+   static constexpr size_t rank_dynamic() noexcept { return Extents::rank_dynamic(); }
+   static constexpr size_t static_extent( size_t r ) noexcept { return Extents::static_extent( r ); }
+
+   constexpr mdspan() noexcept = default;
+
+   template< typename... Ints >
+      requires( sizeof...(Ints) == Extents::rank_dynamic() && ( std::is_convertible_v<Ints,size_t> && ... ) )
+   constexpr explicit mdspan( T* ptr, Ints... dynamic ) noexcept
+      : ptr_( ptr )
+      , mapping_( Extents( dynamic... ) )
+   {}
+
+   constexpr mdspan( T* ptr, mapping_type const& mapping ) noexcept
+      : ptr_( ptr )
+      , mapping_( mapping )
+   {}
+
+   // Multi-dimensional view on the elements of the given span
+   template< size_t N, typename... Ints >
+      requires( sizeof...(Ints) == Extents::rank_dynamic() && ( std::is_convertible_v<Ints,size_t> && ... ) )
+   constexpr explicit mdspan( std::span<T,N> s, Ints... dynamic ) noexcept
+      : mdspan( s.data(), dynamic... )
+   {
+      assert( mapping_.required_span_size() <= s.size() );
+   }
+
+   template< typename... Indices >
+      requires( sizeof...(Indices) == Extents::rank() && ( std::is_convertible_v<Indices,size_t> && ... ) )
+   constexpr reference operator()( Indices... indices ) const noexcept
+   {
+      return ptr_[mapping_( static_cast<size_t>( indices )... )];
+   }
+
+   constexpr size_t extent( size_t r ) const noexcept { return mapping_.extents().extent( r ); }
+   constexpr size_t stride( size_t r ) const noexcept { return mapping_.stride( r ); }
+   constexpr size_t size()             const noexcept { return mapping_.extents().size(); }
+   constexpr bool   empty()            const noexcept { return size() == 0U; }
+
+   constexpr Extents const&      extents()     const noexcept { return mapping_.extents(); }
+   constexpr mapping_type const& mapping()     const noexcept { return mapping_; }
+   constexpr pointer             data_handle() const noexcept { return ptr_; }
+
+   // One-dimensional view on all elements within reach of the mapping
+   constexpr std::span<T> to_span() const noexcept
+   {
+      return std::span<T>( ptr_, mapping_.required_span_size() );
+   }
+
+ private:
+   T* ptr_{ nullptr };
+   [[no_unique_address]] mapping_type mapping_{};
+};
+
+
+
+
+//*************************************************************************************************
+// Slicing
+//*************************************************************************************************
+
+// Slice specifier selecting all indices of a dimension
+struct full_extent_t { explicit full_extent_t() = default; };
+inline constexpr full_extent_t full_extent{};
+
+// Slice specifier selecting the half-open index range [first,last) of a dimension
+struct index_range
+{
+   size_t first;
+   size_t last;
+};
+
+// Returns a view on a slice of the given mdspan without copying any element. Every dimension is
+// sliced by an index (which removes the dimension), an 'index_range', or 'full_extent'. The
+// slice always uses a strided layout with dynamic extents.
+template< typename T, typename Extents, typename Layout, typename... Slices >
+   requires( sizeof...(Slices) == Extents::rank() )
+constexpr auto submdspan( mdspan<T,Extents,Layout> const& m, Slices... slices )
+{
+   constexpr size_t R = ( size_t{ !std::is_convertible_v<Slices,size_t> } + ... + 0U );
+
+   std::array<size_t,R> sizes{};
+   std::array<size_t,R> strides{};
+   size_t offset{}, k{};
+
+   [&]<size_t... Is>( std::index_sequence<Is...> ) {
+      ( [&]( auto const& slice, size_t r ) {
+         using Slice = std::remove_cvref_t< decltype(slice) >;
+
+         if constexpr( std::is_convertible_v<Slice,size_t> ) {
+            assert( static_cast<size_t>( slice ) < m.extent( r ) );
+            offset += static_cast<size_t>( slice ) * m.stride( r );
+         }
+         else if constexpr( std::is_same_v<Slice,full_extent_t> ) {
+            sizes[k]   = m.extent( r );
+            strides[k] = m.stride( r );
+            ++k;
+         }
+         else {
+            static_assert( std::is_same_v<Slice,index_range>, "Invalid slice specifier" );
+            assert( slice.first <= slice.last && slice.last <= m.extent( r ) );
+            offset    += slice.first * m.stride( r );
+            sizes[k]   = slice.last - slice.first;
+            strides[k] = m.stride( r );
+            ++k;
+         }
+      }( slices, Is ), ... );
+   }( std::index_sequence_for<Slices...>{} );
+
+   using Mapping = layout_stride::mapping< dextents<R> >;
+   return mdspan< T, dextents<R>, layout_stride >( m.data_handle() + offset,
+                                                   Mapping( dextents<R>( sizes ), strides ) );
+}
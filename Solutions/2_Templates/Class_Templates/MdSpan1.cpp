@@ -0,0 +1,165 @@
+/**************************************************************************************************
+*
+* \file MdSpan1.cpp
+* \brief C++ Training - Class Design Example
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Implement the class template 'mdspan', a non-owning multi-dimensional view on top of the
+*       one-dimensional 'span'. The extents can be mixed static and dynamic values and the mapping
+*       of indices to memory offsets is defined by a layout policy:
+*
+*         template< typename T               // Type of the elements
+*                 , typename Extents         // Static and dynamic extents
+*                 , typename Layout = layout_right >  // Row-major, column-major or strided
+*         class mdspan;
+*
+*       In addition, implement the 'submdspan()' function to create zero-copy slices.
+*
+**************************************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "MdSpan.h"
+
+
+// Transposition of 'a' into 'b' in a single pass over all elements
+template< typename MA, typename MB >
+void transpose( MA const& a, MB const& b )
+{
+   for( size_t i=0U; i<a.extent(0); ++i ) {
+      for( size_t j=0U; j<a.extent(1); ++j ) {
+         b(j,i) = a(i,j);
+      }
+   }
+}
+
+// Transposition of 'a' into 'b' tile by tile, where every tile is a zero-copy slice
+template< typename MA, typename MB >
+void transpose_tiled( MA const& a, MB const& b, size_t tile )
+{
+   for( size_t i=0U; i<a.extent(0); i+=tile ) {
+      for( size_t j=0U; j<a.extent(1); j+=tile ) {
+         index_range const rows{ i, std::min( i+tile, a.extent(0) ) };
+         index_range const cols{ j, std::min( j+tile, a.extent(1) ) };
+         transpose( submdspan( a, rows, cols ), submdspan( b, cols, rows ) );
+      }
+   }
+}
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
+int main()
+{
+   // Two-dimensional view on a vector with static and dynamic extents
+   {
+      std::vector<int> v( 12U );
+      std::iota( v.begin(), v.end(), 0 );
+
+      mdspan< int, extents<std::dynamic_extent,4U> > const m( std::span<int>( v ), 3U );
+      static_assert( m.rank() == 2U && m.rank_dynamic() == 1U );
+      static_assert( sizeof( mdspan< int, extents<3U,4U> > ) == sizeof( int* ) );
+
+      // With static extents, the index computation is a compile time constant
+      static_assert( layout_right::mapping< extents<3U,4U> >{}( 1, 2 ) == 6U );
+      static_assert( layout_left::mapping< extents<3U,4U> >{}( 1, 2 ) == 7U );
+
+      assert( m.extent(0) == 3U && m.extent(1) == 4U );
+      assert( m(1,2) == 6 && m.stride(0) == 4U );
+
+      mdspan< int, extents<3U,4U>, layout_left > const c( v.data() );
+      assert( c(1,2) == 7 && c.stride(1) == 3U );
+
+      // Zero-copy slices: a row, a column and a block
+      auto const row   = submdspan( m, 1U, full_extent );
+      auto const col   = submdspan( m, full_extent, 2U );
+      auto const block = submdspan( m, index_range{ 1U, 3U }, index_range{ 1U, 3U } );
+      static_assert( decltype(row)::rank() == 1U && decltype(block)::rank() == 2U );
+
+      assert( row(3) == 7 && col(2) == 10 && block(1,1) == 10 );
+      block(0,0) = -1;
+      assert( v[5] == -1 );
+
+      std::cout << "\n Column 2:";
+      for( size_t i=0U; i<col.extent(0); ++i ) {
+         std::cout << ' ' << col(i);
+      }
+      std::cout << "\n\n";
+   }
+
+   // Three-dimensional view
+   {
+      std::vector<double> v( 2U*3U*4U );
+      mdspan< double, extents<2U,3U,4U> > const m( v.data() );
+      m(1,2,3) = 42.0;
+      assert( v.back() == 42.0 );
+
+      [[maybe_unused]] auto const plane = submdspan( m, 1U, full_extent, full_extent );
+      assert( plane(2,3) == 42.0 && plane.to_span().size() == 12U );
+   }
+
+   // Comparison of matrix transpositions with different layouts
+   {
+      constexpr size_t N( 2048U );
+      constexpr size_t repetitions( 5U );
+      constexpr double gigabytes( 2.0 * N * N * sizeof(double) / 1E9 );
+
+      std::vector<double> a( N*N ), b( N*N );
+      std::iota( a.begin(), a.end(), 0.0 );
+
+      using Dynamic = mdspan< double, dextents<2U> >;
+      using Static  = mdspan< double, extents<N,N> >;
+      using Left    = mdspan< double, extents<N,N>, layout_left >;
+
+      auto const run = [&]( auto transposition ) {
+         double const time = measure( [&]{
+            for( size_t rep=0U; rep<repetitions; ++rep ) transposition();
+         } ) / repetitions;
+         assert( b[1] == a[N] && b[N*N-2U] == a[N*N-1U-N] );
+         std::fill( b.begin(), b.end(), 0.0 );
+         return time;
+      };
+
+      double const t1 = run( [&]{ transpose( Dynamic( a.data(), N, N ), Dynamic( b.data(), N, N ) ); } );
+      double const t2 = run( [&]{ transpose( Static( a.data() ), Static( b.data() ) ); } );
+      double const t3 = run( [&]{ transpose_tiled( Static( a.data() ), Static( b.data() ), 32U ); } );
+      double const t4 = run( [&]{ transpose_tiled( Dynamic( a.data(), N, N ), Dynamic( b.data(), N, N ), 32U ); } );
+
+      // Writing the transpose into a column-major matrix is a sequential copy
+      double const t5 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep ) transpose( Static( a.data() ), Left( b.data() ) );
+      } ) / repetitions;
+      assert( Left( b.data() )(5,7) == Static( a.data() )(7,5) );
+
+      std::cout << " Transposition (" << N << "x" << N << ")              Time        Bandwidth\n"
+                << " row-major, dynamic extents        " << std::setw(9) << t1 << " ms" << std::setw(10) << gigabytes/t1*1E3 << " GB/s\n"
+                << " row-major, static extents         " << std::setw(9) << t2 << " ms" << std::setw(10) << gigabytes/t2*1E3 << " GB/s\n"
+                << " row-major, static, 32x32 tiles    " << std::setw(9) << t3 << " ms" << std::setw(10) << gigabytes/t3*1E3 << " GB/s\n"
+                << " row-major, dynamic, 32x32 tiles   " << std::setw(9) << t4 << " ms" << std::setw(10) << gigabytes/t4*1E3 << " GB/s\n"
+                << " row-major into column-major       " << std::setw(9) << t5 << " ms" << std::setw(10) << gigabytes/t5*1E3 << " GB/s\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,269 @@
+/**************************************************************************************************
+*
+* \file RecordView.h
+* \brief C++ Training - Zero-copy views on packed, fixed-layout binary records
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+**************************************************************************************************/
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include "Span.h"
+
+#pragma once
+
+
+//*************************************************************************************************
+// Byte order conversion
+//*************************************************************************************************
+
+namespace detail {
+
+template< size_t N > struct unsigned_of;
+template<> struct unsigned_of<1U> { using type = uint8_t;  };
+template<> struct unsigned_of<2U> { using type = uint16_t; };
+template<> struct unsigned_of<4U> { using type = uint32_t; };
+template<> struct unsigned_of<8U> { using type = uint64_t; };
+
+template< size_t N >
+using unsigned_of_t = typename unsigned_of<N>::type;
+
+// Replacement for the C++23 'std::byteswap()'
+template< typename U >
+constexpr U byteswap( U value ) noexcept
+{
+#if defined(__cpp_lib_byteswap)
+   return std::byteswap( value );
+#elif defined(__GNUC__) || defined(__clang__)
+   if constexpr( sizeof(U) == 1U ) return value;
+   else if constexpr( sizeof(U) == 2U ) return static_cast<U>( __builtin_bswap16( value ) );
+   else if constexpr( sizeof(U) == 4U ) return static_cast<U>( __builtin_bswap32( value ) );
+   else return static_cast<U>( __builtin_bswap64( value ) );
+#else
+   U result( 0 );
+   for( size_t i=0U; i<sizeof(U); ++i ) {
+      result = static_cast<U>( ( result << 8U ) | ( value & 0xFFU ) );
+      value  = static_cast<U>( value >> 8U );
+   }
+   return result;
+#endif
+}
+
+// Reads a value of type 'T' stored in byte order 'E' from a potentially unaligned address
+template< typename T, std::endian E >
+T load( std::byte const* ptr ) noexcept
+{
+   using U = unsigned_of_t<sizeof(T)>;
+
+   U raw;
+   std::memcpy( &raw, ptr, sizeof(U) );
+   if constexpr( E != std::endian::native && sizeof(U) > 1U ) {
+      raw = byteswap( raw );
+   }
+   return std::bit_cast<T>( raw );
+}
+
+// Writes a value of type 'T' in byte order 'E' to a potentially unaligned address
+template< typename T, std::endian E >
+void store( std::byte* ptr, T value ) noexcept
+{
+   using U = unsigned_of_t<sizeof(T)>;
+
+   U raw( std::bit_cast<U>( value ) );
+   if constexpr( E != std::endian::native && sizeof(U) > 1U ) {
+      raw = byteswap( raw );
+   }
+   std::memcpy( ptr, &raw, sizeof(U) );
+}
+
+} // namespace detail
+
+
+//*************************************************************************************************
+// Record layouts
+//*************************************************************************************************
+
+// A single field of type 'T' stored in byte order 'E'
+template< typename T, std::endian E >
+struct field
+{
+   static_assert( std::is_trivially_copyable_v<T>, "Fields must be trivially copyable" );
+   static_assert( sizeof(T) == 1U || sizeof(T) == 2U || sizeof(T) == 4U || sizeof(T) == 8U
+                , "Unsupported field size" );
+
+   using type = T;
+   static constexpr std::endian endian = E;
+};
+
+template< typename T > using big_endian    = field<T,std::endian::big>;
+template< typename T > using little_endian = field<T,std::endian::little>;
+template< typename T > using network_order = big_endian<T>;
+
+// The layout of a packed record, i.e. a sequence of fields without any padding in between
+template< typename... Fields >
+struct packed_layout
+{
+   static constexpr size_t fields = sizeof...(Fields);
+   static constexpr size_t size   = ( size_t{0} + ... + sizeof(typename Fields::type) );
+
+   template< size_t I >
+   using field_type = std::tuple_element_t< I, std::tuple<Fields...> >;
+
+   template< size_t I >
+   static constexpr size_t offset = []{
+      constexpr std::array<size_t,sizeof...(Fields)> sizes{ sizeof(typename Fields::type)... };
+      size_t result( 0U );
+      for( size_t i=0U; i<I; ++i ) result += sizes[i];
+      return result;
+   }();
+};
+
+
+//*************************************************************************************************
+// Class definition of record_view
+//*************************************************************************************************
+
+// Non-owning view on a single record. Fields are decoded on access only, i.e. fields that are
+// never read are never touched. 'Byte' is 'std::byte const' for read-only and 'std::byte' for
+// writable records.
+template< typename Layout, typename Byte = std::byte const >
+class record_view
+{
+ public:
+   using layout = Layout;
+
+   static constexpr size_t size = Layout::size;
+
+   template< size_t I >
+   using value_type = typename Layout::template field_type<I>::type;
+
+   explicit constexpr record_view( std::span<Byte,size> bytes ) noexcept
+      : data_( bytes.data() )
+   {}
+
+   explicit constexpr record_view( Byte* ptr ) noexcept
+      : data_( ptr )
+   {}
+
+   template< size_t I >
+   value_type<I> get() const noexcept
+   {
+      using Field = typename Layout::template field_type<I>;
+      return detail::load< typename Field::type, Field::endian >( data_ + Layout::template offset<I> );
+   }
+
+   template< size_t I >
+   void set( value_type<I> value ) const noexcept requires( !std::is_const_v<Byte> )
+   {
+      using Field = typename Layout::template field_type<I>;
+      detail::store< typename Field::type, Field::endian >( data_ + Layout::template offset<I>, value );
+   }
+
+   std::span<Byte,size> bytes() const noexcept { return std::span<Byte,size>( data_, size ); }
+
+ private:
+   Byte* data_;
+};
+
+
+//*************************************************************************************************
+// Class definition of record_span
+//*************************************************************************************************
+
+// Non-owning view on a contiguous sequence of records. Trailing bytes, which do not form an
+// entire record, are ignored.
+template< typename Layout, typename Byte = std::byte const >
+class record_span
+{
+ public:
+   using value_type = record_view<Layout,Byte>;
+
+   class iterator
+   {
+    public:
+      // The iterator returns proxies by value, i.e. it is only a C++17 input iterator, but models
+      // the C++20 'random_access_iterator' concept
+      using iterator_concept  = std::random_access_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type        = record_view<Layout,Byte>;
+      using difference_type   = std::ptrdiff_t;
+      using reference         = value_type;
+      using pointer           = void;
+
+      iterator() = default;
+      explicit iterator( Byte* ptr ) noexcept : ptr_( ptr ) {}
+
+      reference operator*() const noexcept { return value_type( ptr_ ); }
+      reference operator[]( difference_type n ) const noexcept { return value_type( ptr_ + n*static_cast<difference_type>( Layout::size ) ); }
+
+      iterator& operator++() noexcept { ptr_ += Layout::size; return *this; }
+      iterator  operator++(int) noexcept { iterator tmp( *this ); ++*this; return tmp; }
+      iterator& operator--() noexcept { ptr_ -= Layout::size; return *this; }
+      iterator  operator--(int) noexcept { iterator tmp( *this ); --*this; return tmp; }
+
+      iterator& operator+=( difference_type n ) noexcept { ptr_ += n*static_cast<difference_type>( Layout::size ); return *this; }
+      iterator& operator-=( difference_type n ) noexcept { ptr_ -= n*static_cast<difference_type>( Layout::size ); return *this; }
+
+      friend iterator operator+( iterator it, difference_type n ) noexcept { return it += n; }
+      friend iterator operator+( difference_type n, iterator it ) noexcept { return it += n; }
+      friend iterator operator-( iterator it, difference_type n ) noexcept { return it -= n; }
+
+      friend difference_type operator-( iterator const& a, iterator const& b ) noexcept
+      {
+         return ( a.ptr_ - b.ptr_ ) / static_cast<difference_type>( Layout::size );
+      }
+
+      friend bool operator==( iterator const&, iterator const& ) = default;
+      friend auto operator<=>( iterator const&, iterator const& ) = default;
+
+    private:
+      Byte* ptr_{ nullptr };
+   };
+
+   constexpr record_span() = default;
+
+   explicit constexpr record_span( std::span<Byte> bytes ) noexcept
+      : data_( bytes.data() )
+      , size_( bytes.size() / Layout::size )
+   {}
+
+   size_t size()  const noexcept { return size_; }
+   bool   empty() const noexcept { return size_ == 0U; }
+
+   value_type operator[]( size_t index ) const noexcept
+   {
+      assert( index < size_ );
+      return value_type( data_ + index*Layout::size );
+   }
+
+   iterator begin() const noexcept { return iterator( data_ ); }
+   iterator end()   const noexcept { return iterator( data_ + size_*Layout::size ); }
+
+ private:
+   Byte*  data_{ nullptr };
+   size_t size_{ 0U };
+};
+
+template< typename Layout >
+record_span<Layout,std::byte const> records( std::span<std::byte const> bytes ) noexcept
+{
+   return record_span<Layout,std::byte const>( bytes );
+}
+
+template< typename Layout >
+record_span<Layout,std::byte> writable_records( std::span<std::byte> bytes ) noexcept
+{
+   return record_span<Layout,std::byte>( bytes );
+}
@@ -0,0 +1,217 @@
+/**************************************************************************************************
+*
+* \file RecordView1.cpp
+* \brief C++ Training - Class Design Example
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Implement the class template 'record_view', a zero-copy view on a packed binary record.
+*       The layout of the record is described by a sequence of fields with a specific byte order:
+*
+*         using Layout = packed_layout< network_order<uint64_t>, little_endian<double> >;
+*
+*         record_view<Layout> record( bytes );
+*         uint64_t const id = record.get<0>();  // Decoded on access, swapped only if necessary
+*
+**************************************************************************************************/
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "RecordView.h"
+
+
+// Wire format of an order: 28 bytes without padding
+using OrderLayout = packed_layout< network_order<uint64_t>  // Order ID
+                                 , network_order<uint32_t>  // Timestamp (microseconds)
+                                 , little_endian<double>    // Price
+                                 , little_endian<int32_t>   // Quantity
+                                 , network_order<uint16_t>  // Symbol
+                                 , little_endian<uint8_t>   // Side (0: buy, 1: sell)
+                                 , little_endian<uint8_t>   // Flags
+                                 >;
+
+enum OrderField : size_t { id, timestamp, price, quantity, symbol, side, flags };
+
+static_assert( OrderLayout::size == 28U );
+static_assert( OrderLayout::offset<price> == 12U && OrderLayout::offset<flags> == 27U );
+static_assert( detail::byteswap( uint32_t{0x11223344U} ) == 0x44332211U );
+
+// The traditional approach: copy the record into a packed struct and fix the byte order
+#pragma pack(push,1)
+struct WireOrder
+{
+   uint64_t id;
+   uint32_t timestamp;
+   double   price;
+   int32_t  quantity;
+   uint16_t symbol;
+   uint8_t  side;
+   uint8_t  flags;
+};
+#pragma pack(pop)
+
+static_assert( sizeof(WireOrder) == OrderLayout::size );
+
+struct Order
+{
+   uint64_t id;
+   uint32_t timestamp;
+   double   price;
+   int32_t  quantity;
+   uint16_t symbol;
+   uint8_t  side;
+   uint8_t  flags;
+};
+
+Order decode_by_memcpy( std::byte const* ptr )
+{
+   WireOrder wire;
+   std::memcpy( &wire, ptr, sizeof(WireOrder) );
+
+   Order order{ wire.id, wire.timestamp, wire.price, wire.quantity, wire.symbol, wire.side, wire.flags };
+   if constexpr( std::endian::native == std::endian::little ) {
+      order.id        = detail::byteswap( order.id );
+      order.timestamp = detail::byteswap( order.timestamp );
+      order.symbol    = detail::byteswap( order.symbol );
+   }
+   else {
+      order.price    = std::bit_cast<double>( detail::byteswap( std::bit_cast<uint64_t>( order.price ) ) );
+      order.quantity = static_cast<int32_t>( detail::byteswap( static_cast<uint32_t>( order.quantity ) ) );
+   }
+   return order;
+}
+
+Order decode_by_view( record_view<OrderLayout> record )
+{
+   return Order{ record.get<id>(), record.get<timestamp>(), record.get<price>(), record.get<quantity>()
+               , record.get<symbol>(), record.get<side>(), record.get<flags>() };
+}
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
+int main()
+{
+   constexpr size_t N( 4'000'000U );
+   constexpr size_t repetitions( 5U );
+
+   std::vector<std::byte> buffer( N*OrderLayout::size + 5U );  // Incl. an incomplete record
+
+   // Encoding of the orders via writable records
+   {
+      std::mt19937 rng( 42U );
+      std::uniform_int_distribution<int32_t> dist( 1, 1000 );
+
+      auto const orders = writable_records<OrderLayout>( buffer );
+      assert( orders.size() == N );
+
+      uint64_t i( 0U );
+      for( auto const order : orders ) {
+         order.set<id>( 0x0102030405060708ULL + i );
+         order.set<timestamp>( static_cast<uint32_t>( i ) );
+         order.set<price>( dist( rng ) * 0.25 );
+         order.set<quantity>( dist( rng ) );
+         order.set<symbol>( static_cast<uint16_t>( i % 500U ) );
+         order.set<side>( static_cast<uint8_t>( i % 2U ) );
+         order.set<flags>( 0U );
+         ++i;
+      }
+   }
+
+   auto const orders = records<OrderLayout>( buffer );
+
+   // The first bytes of the buffer are the big endian order ID
+   assert( buffer[0] == std::byte{0x01} && buffer[7] == std::byte{0x08} );
+   assert( orders[0].get<id>() == 0x0102030405060708ULL );
+   assert( orders[3].get<timestamp>() == 3U && orders[3].get<side>() == 1U );
+   assert( orders.end() - orders.begin() == static_cast<std::ptrdiff_t>( N ) );
+
+   {
+      [[maybe_unused]] Order const a = decode_by_memcpy( buffer.data() + 7U*OrderLayout::size );
+      [[maybe_unused]] Order const b = decode_by_view( orders[7] );
+      assert( a.id == b.id && a.price == b.price && a.quantity == b.quantity && a.symbol == b.symbol );
+   }
+
+   // Comparison of the decoding strategies for a filter over three of seven fields
+   {
+      double result( 0.0 );
+      double expected( 0.0 );
+
+      double const t1 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep ) {
+            result = 0.0;
+            for( size_t i=0U; i<N; ++i ) {
+               Order const order = decode_by_memcpy( buffer.data() + i*OrderLayout::size );
+               if( order.side == 0U ) result += order.price * order.quantity;
+            }
+         }
+      } ) / repetitions;
+      expected = result;
+
+      double const t2 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep ) {
+            result = 0.0;
+            for( auto const order : orders ) {
+               Order const decoded = decode_by_view( order );
+               if( decoded.side == 0U ) result += decoded.price * decoded.quantity;
+            }
+         }
+      } ) / repetitions;
+      bool consistent( result == expected );
+
+      double const t3 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep ) {
+            result = 0.0;
+            for( auto const order : orders ) {
+               if( order.get<side>() == 0U ) result += order.get<price>() * order.get<quantity>();
+            }
+         }
+      } ) / repetitions;
+      consistent &= ( result == expected );
+
+      // Only the network order fields require a byte swap on a little endian host
+      uint64_t ids( 0U );
+      double const t4 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep ) {
+            ids = 0U;
+            for( auto const order : orders ) {
+               ids += order.get<id>() ^ order.get<symbol>();
+            }
+         }
+      } ) / repetitions;
+
+      auto const rate = [&]( double ms ){ return N / ms / 1E3; };
+
+      std::cout << "\n Decoding " << N << " records (" << OrderLayout::size << " bytes each)      Time       Records\n"
+                << " memcpy into struct + byteswap     " << std::setw(9) << t1 << " ms" << std::setw(9) << rate(t1) << " M/s\n"
+                << " record_view, all fields           " << std::setw(9) << t2 << " ms" << std::setw(9) << rate(t2) << " M/s\n"
+                << " record_view, lazy (3 fields)      " << std::setw(9) << t3 << " ms" << std::setw(9) << rate(t3) << " M/s\n"
+                << " record_view, 2 swapped fields     " << std::setw(9) << t4 << " ms" << std::setw(9) << rate(t4) << " M/s\n"
+                << " Results consistent: " << std::boolalpha << consistent << " (checksum " << ( ids & 0xFFFFU ) << ")\n\n";
+      assert( consistent );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,864 @@
+/**************************************************************************************************
+*
+* \file SmallVector1.cpp
+* \brief C++ Training - Class Design Example
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Implement the class template 'SmallVector'. A small vector represents a hybrid between
+*       'FixedVector' and 'Vector', i.e. it holds up to 'N' elements in static memory and only
+*       spills to dynamic memory in case more elements are required.
+*
+*         template< typename Type                            // Type of the elements
+*                 , size_t N                                 // Number of inline elements
+*                 , typename Allocator = std::allocator<Type> // Allocator for spilled elements
+*                 , typename GrowthPolicy = DoublingGrowth >  // Growth beyond 'N' elements
+*         class SmallVector;
+*
+*       Moving a small vector should steal the dynamic memory of a spilled vector, but move
+*       the elements of an inline vector one by one.
+*
+**************************************************************************************************/
+
+//---- BEGIN OF <Vector.h> ------------------------------------------------------------------------
+
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using std::size_t;
+
+
+//*************************************************************************************************
+// Uninitialized memory algorithms
+//*************************************************************************************************
+
+template< typename T, typename... Args >
+constexpr T* construct_at( T* p, Args&&... args )
+{
+   void* address = const_cast<void*>(static_cast<const volatile void*>(p));
+   return ::new (address) T( std::forward<Args>(args)... );
+}
+
+
+template< typename T >
+constexpr void destroy_at( T* p )
+{
+   p->~T();
+}
+
+
+template< typename ForwardIt >
+constexpr void destroy( ForwardIt first, ForwardIt last )
+{
+   for( ; first!=last; ++first ) {
+      ::destroy_at( std::addressof(*first) );  // or since C++17 std::destroy_at
+   }
+}
+
+
+// Customization point for types that can be relocated by a plain 'memcpy()' of their bytes,
+// i.e. for which a move construction followed by the destruction of the source is equivalent
+// to copying the object representation. This holds for all trivially copyable types, but
+// may be declared for other types (e.g. types holding a single owning pointer) by means of
+// a specialization.
+template< typename T >
+struct is_trivially_relocatable
+   : public std::is_trivially_copyable<T>
+{};
+
+template< typename T >
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+// Relocates the elements in the range [first,last) into the uninitialized memory starting at
+// 'dest'. After the call, the source range does not contain any live objects anymore. Elements
+// are memcpy'ed if they are trivially relocatable, moved if their move constructor cannot
+// throw, and copied otherwise. In case a copy throws, the source range remains untouched.
+template< typename T >
+T* uninitialized_relocate( T* first, T* last, T* dest )
+{
+   if constexpr( is_trivially_relocatable_v<T> ) {
+      if( first != last ) {
+         std::memcpy( static_cast<void*>( dest ), static_cast<const void*>( first )
+                    , static_cast<size_t>( last - first ) * sizeof(T) );
+      }
+      return dest + ( last - first );
+   }
+   else if constexpr( std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T> ) {
+      T* const result = std::uninitialized_move( first, last, dest );
+      ::destroy( first, last );
+      return result;
+   }
+   else {
+      T* const result = std::uninitialized_copy( first, last, dest );
+      ::destroy( first, last );
+      return result;
+   }
+}
+
+
+//*************************************************************************************************
+// Growth policies
+//*************************************************************************************************
+
+// Geometric growth by the factor 'Num/Den'. The first allocation holds a cache line worth of
+// elements (but at least one element) to avoid a series of tiny reallocations.
+template< size_t Num, size_t Den >
+struct GeometricGrowth
+{
+   static_assert( Num > Den, "The growth factor must be larger than 1" );
+
+   constexpr size_t operator()( size_t capacity, size_t elementSize ) const noexcept
+   {
+      if( capacity == 0UL ) {
+         return std::max( 64UL / elementSize, 1UL );
+      }
+      return std::max( capacity * Num / Den, capacity + 1UL );
+   }
+};
+
+using DoublingGrowth   = GeometricGrowth<2UL,1UL>;
+using OneAndHalfGrowth = GeometricGrowth<3UL,2UL>;
+
+
+// Growth by the factor 1.5, where allocations of at least one page are rounded up to a
+// multiple of the page size. This avoids partially used pages at the end of large buffers.
+template< size_t PageSize = 4096UL >
+struct PageRoundedGrowth
+{
+   constexpr size_t operator()( size_t capacity, size_t elementSize ) const noexcept
+   {
+      const size_t bytes( OneAndHalfGrowth{}( capacity, elementSize ) * elementSize );
+
+      if( bytes < PageSize ) {
+         return bytes / elementSize;
+      }
+      return ( bytes + PageSize - 1UL ) / PageSize * PageSize / elementSize;
+   }
+};
+
+
+//*************************************************************************************************
+// Class definition
+//*************************************************************************************************
+
+template< typename Type
+        , typename Allocator = std::allocator<Type>
+        , typename GrowthPolicy = DoublingGrowth >
+class Vector
+{
+ public:
+   using iterator       = Type*;
+   using const_iterator = const Type*;
+   using allocator_type = Allocator;
+
+   Vector() = default;
+   explicit Vector( const Allocator& alloc );
+   Vector( const Vector& sv );
+   Vector( const Vector& sv, const Allocator& alloc );
+   Vector( Vector&& sv );
+
+   Vector& operator=( const Vector& sv );
+   Vector& operator=( Vector&& sv );
+   Vector& operator=( std::initializer_list<Type> list );
+
+   ~Vector();
+
+   void push_back( const Type& s );
+   void push_back( Type&& s );
+
+   template< typename... Args >
+   void emplace_back( Args&&... args );
+
+   size_t size() const;
+   size_t capacity() const;
+
+   void reserve( size_t n );
+   void shrink_to_fit();
+
+   allocator_type get_allocator() const;
+
+   Type&       operator[]( size_t index );
+   const Type& operator[]( size_t index ) const;
+
+   iterator       begin();
+   iterator       end();
+   const_iterator begin() const;
+   const_iterator end()   const;
+
+   void swap( Vector& sv );
+
+ private:
+   using AllocTraits = std::allocator_traits<Allocator>;
+
+   void reallocate( size_t n );
+   void free();
+
+   // Per-instance allocator; stateless allocators don't occupy any storage
+   [[no_unique_address]] Allocator alloc_{};
+
+   Type* begin_{ nullptr };
+   Type* end_  { nullptr };
+   Type* final_{ nullptr };
+};
+
+
+//*************************************************************************************************
+// Member function definitions
+//*************************************************************************************************
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Allocator& alloc )
+   : alloc_( alloc )
+{}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Vector& sv )
+   : Vector( sv, AllocTraits::select_on_container_copy_construction( sv.alloc_ ) )
+{}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Vector& sv, const Allocator& alloc )
+   : alloc_( alloc )
+   , begin_( AllocTraits::allocate( alloc_, sv.size() ) )
+   , end_  ( std::uninitialized_copy( sv.begin(), sv.end(), begin_ ) )
+   , final_( end_ )
+{}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( Vector&& sv )
+   : alloc_( std::move(sv.alloc_) )
+   , begin_( sv.begin_ )
+   , end_  ( sv.end_   )
+   , final_( sv.final_ )
+{
+   sv.begin_ = nullptr;
+   sv.end_   = nullptr;
+   sv.final_ = nullptr;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( const Vector& sv )
+{
+   constexpr bool propagate( AllocTraits::propagate_on_container_copy_assignment::value );
+
+   Vector tmp( sv, propagate ? sv.alloc_ : alloc_ );
+
+   using std::swap;
+
+   if constexpr( propagate ) {
+      swap( alloc_, tmp.alloc_ );
+   }
+
+   swap( begin_, tmp.begin_ );
+   swap( end_  , tmp.end_   );
+   swap( final_, tmp.final_ );
+
+   return *this;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( Vector&& sv )
+{
+   constexpr bool propagate( AllocTraits::propagate_on_container_move_assignment::value );
+
+   // Memory of a different, non-propagating allocator cannot be adopted and requires to move
+   // the elements one by one
+   if constexpr( !propagate && !AllocTraits::is_always_equal::value ) {
+      if( alloc_ != sv.alloc_ ) {
+         Vector tmp( alloc_ );
+         tmp.begin_ = AllocTraits::allocate( tmp.alloc_, sv.size() );
+         tmp.end_   = tmp.begin_;
+         tmp.final_ = tmp.begin_ + sv.size();
+         tmp.end_   = std::uninitialized_move( sv.begin_, sv.end_, tmp.begin_ );
+         swap( tmp );
+         return *this;
+      }
+   }
+
+   free();
+
+   if constexpr( propagate ) {
+      alloc_ = std::move(sv.alloc_);
+   }
+
+   begin_ = sv.begin_;
+   end_   = sv.end_;
+   final_ = sv.final_;
+
+   sv.begin_ = nullptr;
+   sv.end_   = nullptr;
+   sv.final_ = nullptr;
+
+   return *this;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( std::initializer_list<Type> list )
+{
+   Vector tmp( alloc_ );
+   for( const Type& s : list ) {
+      tmp.push_back( s );
+   }
+   swap( tmp );
+   return *this;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::~Vector()
+{
+   free();
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::push_back( const Type& v )
+{
+   if( end_ == final_ ) {
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
+   }
+
+   ::construct_at( end_, v );  // or since C++20 std::construct_at
+   ++end_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::push_back( Type&& v )
+{
+   if( end_ == final_ ) {
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
+   }
+
+   ::construct_at( end_, std::move(v) );  // or since C++20 std::construct_at
+   ++end_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+template< typename... Args >
+void Vector<Type,Allocator,GrowthPolicy>::emplace_back( Args&&... args )
+{
+   if( end_ == final_ ) {
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
+   }
+
+   ::construct_at( end_, std::forward<Args>(args)... );  // or since C++20 std::construct_at
+   ++end_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+size_t Vector<Type,Allocator,GrowthPolicy>::size() const
+{
+   return end_ - begin_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+size_t Vector<Type,Allocator,GrowthPolicy>::capacity() const
+{
+   return final_ - begin_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::reserve( size_t n )
+{
+   if( n > capacity() ) {
+      reallocate( n );
+   }
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::shrink_to_fit()
+{
+   if( capacity() > size() ) {
+      reallocate( size() );
+   }
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::allocator_type
+   Vector<Type,Allocator,GrowthPolicy>::get_allocator() const
+{
+   return alloc_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Type& Vector<Type,Allocator,GrowthPolicy>::operator[]( size_t index )
+{
+   return begin_[index];
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+const Type& Vector<Type,Allocator,GrowthPolicy>::operator[]( size_t index ) const
+{
+   return begin_[index];
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::iterator
+   Vector<Type,Allocator,GrowthPolicy>::begin()
+{
+   return begin_;
+}
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::iterator
+   Vector<Type,Allocator,GrowthPolicy>::end()
+{
+   return end_;
+}
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::const_iterator
+   Vector<Type,Allocator,GrowthPolicy>::begin() const
+{
+   return begin_;
+}
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::const_iterator
+   Vector<Type,Allocator,GrowthPolicy>::end() const
+{
+   return end_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::swap( Vector& sv )
+{
+   using std::swap;
+
+   if constexpr( AllocTraits::propagate_on_container_swap::value ) {
+      swap( alloc_, sv.alloc_ );
+   }
+   else {
+      // Swapping two vectors with unequal, non-propagating allocators is undefined behavior
+      assert( alloc_ == sv.alloc_ );
+   }
+
+   swap( begin_, sv.begin_ );
+   swap( end_  , sv.end_   );
+   swap( final_, sv.final_ );
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::reallocate( size_t n )
+{
+   auto newbegin( n ? AllocTraits::allocate( alloc_, n ) : nullptr );
+   Type* newend{};
+
+   try {
+      newend = ::uninitialized_relocate( begin_, end_, newbegin );
+   }
+   catch( ... ) {
+      AllocTraits::deallocate( alloc_, newbegin, n );
+      throw;
+   }
+
+   // The old elements have already been relocated, only the memory needs to be released
+   if( begin_ ) {
+      AllocTraits::deallocate( alloc_, begin_, capacity() );
+   }
+
+   begin_ = newbegin;
+   end_   = newend;
+   final_ = begin_ + n;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::free()
+{
+   ::destroy( begin_, end_ );  // or since C++17 std::destroy
+   if( begin_ ) {
+      AllocTraits::deallocate( alloc_, begin_, capacity() );
+   }
+}
+
+#endif
+
+//---- END OF <Vector.h> --------------------------------------------------------------------------
+
+
+//---- BEGIN OF <SmallVector.h> -------------------------------------------------------------------
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+template< typename Type
+        , size_t N
+        , typename Allocator = std::allocator<Type>
+        , typename GrowthPolicy = DoublingGrowth >
+class SmallVector final
+{
+ public:
+   using value_type     = Type;
+   using iterator       = Type*;
+   using const_iterator = Type const*;
+   using allocator_type = Allocator;
+
+   SmallVector() = default;
+
+   explicit SmallVector( Allocator const& alloc )
+      : alloc_( alloc )
+   {}
+
+   SmallVector( SmallVector const& other )
+      : alloc_( AllocTraits::select_on_container_copy_construction( other.alloc_ ) )
+   {
+      try {
+         reserve( other.size() );
+         end_ = std::uninitialized_copy( other.begin(), other.end(), begin_ );
+      }
+      catch( ... ) {
+         release();
+         throw;
+      }
+   }
+
+   SmallVector( SmallVector&& other ) noexcept( std::is_nothrow_move_constructible_v<Type> )
+      : alloc_( std::move( other.alloc_ ) )
+   {
+      steal( other );
+   }
+
+   ~SmallVector()
+   {
+      release();
+   }
+
+   SmallVector& operator=( SmallVector const& other )
+   {
+      if( this == &other ) return *this;
+
+      clear();
+
+      if constexpr( AllocTraits::propagate_on_container_copy_assignment::value ) {
+         if( alloc_ != other.alloc_ ) {
+            release();
+         }
+         alloc_ = other.alloc_;
+      }
+
+      reserve( other.size() );
+      end_ = std::uninitialized_copy( other.begin(), other.end(), begin_ );
+      return *this;
+   }
+
+   SmallVector& operator=( SmallVector&& other )
+      noexcept( std::is_nothrow_move_constructible_v<Type> &&
+                ( AllocTraits::propagate_on_container_move_assignment::value ||
+                  AllocTraits::is_always_equal::value ) )
+   {
+      if( this == &other ) return *this;
+
+      release();
+
+      if constexpr( AllocTraits::propagate_on_container_move_assignment::value ) {
+         alloc_ = std::move( other.alloc_ );
+      }
+
+      if( AllocTraits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_ ) {
+         steal( other );
+      }
+      else {
+         // The dynamic memory of a different allocator cannot be adopted
+         reserve( other.size() );
+         end_ = std::uninitialized_move( other.begin(), other.end(), begin_ );
+         other.clear();
+      }
+      return *this;
+   }
+
+   size_t size()     const noexcept { return end_ - begin_; }
+   size_t capacity() const noexcept { return final_ - begin_; }
+   bool   empty()    const noexcept { return begin_ == end_; }
+
+   // Returns whether the elements are stored in the inline buffer
+   bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+   allocator_type get_allocator() const { return alloc_; }
+
+   Type*       data()       noexcept { return begin_; }
+   Type const* data() const noexcept { return begin_; }
+
+   Type& operator[]( size_t index ) noexcept
+   {
+      assert( index < size() );
+      return begin_[index];
+   }
+
+   Type const& operator[]( size_t index ) const noexcept
+   {
+      assert( index < size() );
+      return begin_[index];
+   }
+
+   iterator       begin()        noexcept { return begin_; }
+   const_iterator begin()  const noexcept { return begin_; }
+   const_iterator cbegin() const noexcept { return begin_; }
+   iterator       end()          noexcept { return end_; }
+   const_iterator end()    const noexcept { return end_; }
+   const_iterator cend()   const noexcept { return end_; }
+
+   void push_back( Type const& value ) { emplace_back( value ); }
+   void push_back( Type&& value ) { emplace_back( std::move( value ) ); }
+
+   template< typename... Args >
+   Type& emplace_back( Args&&... args )
+   {
+      if( end_ == final_ ) {
+         reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
+      }
+
+      Type* const element = ::construct_at( end_, std::forward<Args>( args )... );
+      ++end_;
+      return *element;
+   }
+
+   void pop_back() noexcept
+   {
+      assert( !empty() );
+      --end_;
+      ::destroy_at( end_ );
+   }
+
+   void clear() noexcept
+   {
+      ::destroy( begin_, end_ );
+      end_ = begin_;
+   }
+
+   void reserve( size_t n )
+   {
+      if( n > capacity() ) {
+         reallocate( n );
+      }
+   }
+
+ private:
+   using AllocTraits = std::allocator_traits<Allocator>;
+
+   Type*       inline_data()       noexcept { return reinterpret_cast<Type*>( raw_ ); }
+   Type const* inline_data() const noexcept { return reinterpret_cast<Type const*>( raw_ ); }
+
+   // Moves the elements to a dynamic buffer with capacity 'n'
+   void reallocate( size_t n )
+   {
+      Type* const newbegin( AllocTraits::allocate( alloc_, n ) );
+      Type* newend{};
+
+      try {
+         newend = ::uninitialized_relocate( begin_, end_, newbegin );
+      }
+      catch( ... ) {
+         AllocTraits::deallocate( alloc_, newbegin, n );
+         throw;
+      }
+
+      if( !is_inline() ) {
+         AllocTraits::deallocate( alloc_, begin_, capacity() );
+      }
+
+      begin_ = newbegin;
+      end_   = newend;
+      final_ = newbegin + n;
+   }
+
+   // Destroys all elements and returns to the empty inline buffer
+   void release() noexcept
+   {
+      clear();
+
+      if( !is_inline() ) {
+         AllocTraits::deallocate( alloc_, begin_, capacity() );
+         begin_ = inline_data();
+         end_   = begin_;
+         final_ = begin_ + N;
+      }
+   }
+
+   // Takes over the elements of 'other', which is left empty; requires '*this' to be empty
+   // and inline and both allocators to be interchangeable
+   void steal( SmallVector& other ) noexcept( std::is_nothrow_move_constructible_v<Type> )
+   {
+      if( other.is_inline() ) {
+         end_ = ::uninitialized_relocate( other.begin_, other.end_, begin_ );
+         other.end_ = other.begin_;
+      }
+      else {
+         begin_ = other.begin_;
+         end_   = other.end_;
+         final_ = other.final_;
+
+         other.begin_ = other.inline_data();
+         other.end_   = other.begin_;
+         other.final_ = other.begin_ + N;
+      }
+   }
+
+   [[no_unique_address]] Allocator alloc_{};
+
+   Type* begin_{ inline_data() };
+   Type* end_  { begin_ };
+   Type* final_{ begin_ + N };
+
+   alignas(Type) std::byte raw_[N*sizeof(Type)];
+
+   static_assert( N > 0U, "The number of inline elements must be a non-zero value" );
+};
+
+#endif
+
+//---- END OF <SmallVector.h> ---------------------------------------------------------------------
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+
+template< typename Type, size_t N, typename Allocator, typename GrowthPolicy >
+std::ostream& operator<<( std::ostream& os, SmallVector<Type,N,Allocator,GrowthPolicy> const& v )
+{
+   os << "(";
+   for( auto const& value : v )
+      os << " " << value;
+   os << " )";
+   return os;
+}
+
+
+// Average time in nanoseconds to create a container, fill it with 'n' elements and destroy it
+template< typename Container >
+double benchmark( size_t n, size_t repetitions, size_t& checksum )
+{
+   using Clock = std::chrono::steady_clock;
+
+   const auto start = Clock::now();
+   for( size_t rep=0U; rep<repetitions; ++rep ) {
+      Container c;
+      for( size_t i=0U; i<n; ++i ) {
+         c.push_back( static_cast<int>( i+rep ) );
+      }
+      for( int const value : c ) {
+         checksum += static_cast<size_t>( value );
+      }
+   }
+   const std::chrono::duration<double,std::nano> time = Clock::now() - start;
+
+   return time.count() / repetitions;
+}
+
+
+int main()
+{
+   // Inline and spilled small vectors
+   {
+      SmallVector<std::string,2> v{};
+      v.push_back( "Bjarne"s );
+      v.push_back( "Herb"s );
+      std::cout << " Inline vector: " << v << " (inline: " << v.is_inline() << ")\n";
+
+      v.push_back( "Nicolai"s );
+      std::cout << " Spilled vector: " << v << " (inline: " << v.is_inline() << ")\n";
+   }
+
+   // Move construction steals the dynamic memory of a spilled vector
+   {
+      SmallVector<std::string,2> a{};
+      a.push_back( "Scott"s );
+      a.push_back( "Kate"s );
+      a.push_back( "Jason"s );
+
+      std::string const* const data = a.data();
+      SmallVector<std::string,2> b( std::move(a) );
+      std::cout << " Moved spilled vector: " << b << " (stolen: " << ( b.data() == data ) << ")\n";
+   }
+
+   // Move construction moves the elements of an inline vector one by one
+   {
+      SmallVector<std::string,2> a{};
+      a.push_back( "Scott"s );
+
+      SmallVector<std::string,2> b( std::move(a) );
+      std::cout << " Moved inline vector: " << b << " (inline: " << b.is_inline() << ")\n";
+   }
+
+   // Copy assignment
+   {
+      SmallVector<int,4> a{};
+      SmallVector<int,4> b{};
+      for( int i=0; i<6; ++i ) {
+         a.push_back( i );
+      }
+      b = a;
+      std::cout << " Copied vector: " << b << "\n\n";
+   }
+
+   // Comparison of 'std::vector', 'Vector' and 'SmallVector' for 0 to 64 elements
+   {
+      constexpr size_t repetitions( 100000U );
+      size_t checksum{};
+
+      std::cout << " Elements   std::vector        Vector   SmallVector<int,8>\n";
+      for( size_t n : { 0U, 1U, 2U, 4U, 8U, 16U, 32U, 64U } ) {
+         const double t1 = benchmark< std::vector<int>  >( n, repetitions, checksum );
+         const double t2 = benchmark< Vector<int>       >( n, repetitions, checksum );
+         const double t3 = benchmark< SmallVector<int,8> >( n, repetitions, checksum );
+
+         std::cout << std::setw(9)  << n
+                   << std::setw(11) << t1 << " ns"
+                   << std::setw(11) << t2 << " ns"
+                   << std::setw(18) << t3 << " ns\n";
+      }
+      std::cout << " (checksum " << checksum << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -19,10 +19,22 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 
 //---- <Widget.h> ---------------------------------------------------------------------------------
@@ -63,12 +75,22 @@ class Widget
 template< typename T >
 struct default_delete
 {
+   constexpr default_delete() noexcept = default;
+
+   template< typename U, typename = std::enable_if_t< std::is_convertible_v<U*,T*> > >
+   default_delete( default_delete<U> const& ) noexcept {}
+
    void operator()( T* ptr ) const { delete ptr; }
 };
 
 template< typename T >
 struct default_delete<T[]>
 {
+   constexpr default_delete() noexcept = default;
+
+   template< typename U, typename = std::enable_if_t< std::is_convertible_v<U(*)[],T(*)[]> > >
+   default_delete( default_delete<U[]> const& ) noexcept {}
+
    template< typename U >
    void operator()( U* ptr ) const { delete[] ptr; }
 };
@@ -86,6 +108,8 @@ class unique_ptr
 
    constexpr unique_ptr();
    explicit  unique_ptr( T* ptr );
+             unique_ptr( T* ptr, D const& d );
+             unique_ptr( T* ptr, D&& d );
              unique_ptr( unique_ptr const& u ) = delete;
              unique_ptr( unique_ptr&& u ) noexcept;
 
@@ -106,8 +130,12 @@ class unique_ptr
    void    reset  ( pointer ptr = pointer{} ) noexcept;
    pointer release() noexcept;
 
+   D&       get_deleter()       noexcept { return deleter_; }
+   D const& get_deleter() const noexcept { return deleter_; }
+
  private:
    T* ptr_;
+   [[no_unique_address]] D deleter_;  // Stateless deleters don't occupy any memory
 
    template< typename U, typename E > friend class unique_ptr;
 };
@@ -116,18 +144,35 @@ class unique_ptr
 template< typename T, typename D >
 constexpr unique_ptr<T,D>::unique_ptr()
    : ptr_( nullptr )
+   , deleter_()
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T,D>::unique_ptr( T* ptr )
    : ptr_( ptr )
+   , deleter_()
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( T* ptr, D const& d )
+   : ptr_( ptr )
+   , deleter_( d )
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( T* ptr, D&& d )
+   : ptr_( ptr )
+   , deleter_( std::move( d ) )
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T,D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -137,6 +182,7 @@ template< typename T, typename D >
 template< typename U, typename E >
 unique_ptr<T,D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -145,16 +191,17 @@ unique_ptr<T,D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
 template< typename T, typename D >
 unique_ptr<T,D>::~unique_ptr() noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
 }
 
 
 template< typename T, typename D >
 unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -163,9 +210,10 @@ template< typename T, typename D >
 template< typename U, typename E >
 unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr<U,E>&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -173,7 +221,7 @@ unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr<U,E>&& u ) noexcept
 template< typename T, typename D >
 void unique_ptr<T,D>::reset( pointer ptr ) noexcept
 {
-   unique_ptr tmp( std::exchange( ptr_, ptr ) );
+   deleter_( std::exchange( ptr_, ptr ) );
 }
 
 
@@ -196,6 +244,8 @@ class unique_ptr<T[],D>
 
    constexpr unique_ptr();
    explicit  unique_ptr( T* ptr );
+             unique_ptr( T* ptr, D const& d );
+             unique_ptr( T* ptr, D&& d );
              unique_ptr( unique_ptr const& u ) = delete;
              unique_ptr( unique_ptr&& u ) noexcept;
 
@@ -218,8 +268,12 @@ class unique_ptr<T[],D>
    void    reset( std::nullptr_t ptr = nullptr ) noexcept;
    pointer release() noexcept;
 
+   D&       get_deleter()       noexcept { return deleter_; }
+   D const& get_deleter() const noexcept { return deleter_; }
+
  private:
    T* ptr_;
+   [[no_unique_address]] D deleter_;  // Stateless deleters don't occupy any memory
 
    template< typename U, typename E > friend class unique_ptr;
 };
@@ -228,18 +282,35 @@ class unique_ptr<T[],D>
 template< typename T, typename D >
 constexpr unique_ptr<T[],D>::unique_ptr()
    : ptr_( nullptr )
+   , deleter_()
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>::unique_ptr( T* ptr )
    : ptr_( ptr )
+   , deleter_()
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( T* ptr, D const& d )
+   : ptr_( ptr )
+   , deleter_( d )
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( T* ptr, D&& d )
+   : ptr_( ptr )
+   , deleter_( std::move( d ) )
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -249,6 +320,7 @@ template< typename T, typename D >
 template< typename U, typename E >
 unique_ptr<T[],D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -257,16 +329,17 @@ unique_ptr<T[],D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
 template< typename T, typename D >
 unique_ptr<T[],D>::~unique_ptr() noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
 }
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -275,9 +348,10 @@ template< typename T, typename D >
 template< typename U, typename E >
 unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr<U,E>&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -287,14 +361,14 @@ template< typename U >
 void unique_ptr<T[],D>::reset( U ptr ) noexcept
 {
    std::cerr << "\n HERE!!!\n\n";
-   unique_ptr tmp( std::exchange( ptr_, ptr ) );
+   deleter_( std::exchange( ptr_, ptr ) );
 }
 
 
 template< typename T, typename D >
 void unique_ptr<T[],D>::reset( std::nullptr_t ptr ) noexcept
 {
-   unique_ptr tmp( std::exchange( ptr_, ptr ) );
+   deleter_( std::exchange( ptr_, ptr ) );
 }
 
 
@@ -317,6 +391,557 @@ unique_ptr<T> make_unique( Ts&&... params )
 
 
 
+
+//---- <Pool.h> -----------------------------------------------------------------------------------
+
+// Pool for memory chunks of a fixed size and alignment. Every thread allocates from and returns
+// to its own thread-local cache. Surplus chunks are handed to a global lock-free list in batches,
+// which serves as fallback for threads with an empty cache. Since the global list is only ever
+// emptied as a whole, it is not affected by the ABA problem of lock-free stacks.
+template< size_t Size, size_t Alignment >
+class FixedSizePool
+{
+ public:
+   static FixedSizePool& instance()
+   {
+      static FixedSizePool pool{};
+      return pool;
+   }
+
+   FixedSizePool( FixedSizePool const& ) = delete;
+   FixedSizePool& operator=( FixedSizePool const& ) = delete;
+
+   ~FixedSizePool()
+   {
+      Node* block = blocks_.load();
+      while( block ) {
+         ::operator delete( std::exchange( block, block->next ), std::align_val_t{ alignment } );
+      }
+   }
+
+   void* allocate()
+   {
+      Cache& cache = cache_;
+
+      if( !cache.head ) {
+         refill( cache );
+      }
+
+      Node* const node = cache.head;
+      cache.head = node->next;
+      --cache.count;
+      return node;
+   }
+
+   void deallocate( void* ptr ) noexcept
+   {
+      Cache& cache = cache_;
+
+      Node* const node = static_cast<Node*>( ptr );
+      node->next = cache.head;
+      cache.head = node;
+      ++cache.count;
+
+      if( cache.count >= 2U*batchSize ) {
+         Node* const first = cache.head;
+         Node* last = first;
+         for( size_t i=1U; i<batchSize; ++i ) {
+            last = last->next;
+         }
+         cache.head = last->next;
+         cache.count -= batchSize;
+         push( free_, first, last );
+      }
+   }
+
+ private:
+   struct Node
+   {
+      Node* next;
+   };
+
+   struct Cache
+   {
+      ~Cache()
+      {
+         if( head ) {
+            Node* last = head;
+            while( last->next ) {
+               last = last->next;
+            }
+            push( instance().free_, head, last );
+         }
+      }
+
+      Node*  head { nullptr };
+      size_t count{ 0U };
+   };
+
+   static constexpr size_t alignment = std::max( Alignment, alignof(Node) );
+   static constexpr size_t chunkSize =
+      ( std::max( Size, sizeof(Node) ) + alignment - 1U ) / alignment * alignment;
+   static constexpr size_t batchSize = 64U;
+
+   FixedSizePool() = default;
+
+   static void push( std::atomic<Node*>& list, Node* first, Node* last ) noexcept
+   {
+      Node* head = list.load( std::memory_order_relaxed );
+      do {
+         last->next = head;
+      } while( !list.compare_exchange_weak( head, first, std::memory_order_release
+                                                       , std::memory_order_relaxed ) );
+   }
+
+   void refill( Cache& cache )
+   {
+      // Take over all chunks of the global list...
+      Node* head = free_.exchange( nullptr, std::memory_order_acquire );
+
+      if( head ) {
+         size_t count{ 0U };
+         for( Node* node=head; node; node=node->next ) {
+            ++count;
+         }
+         cache.head  = head;
+         cache.count = count;
+         return;
+      }
+
+      // ...or carve a new batch of chunks out of a fresh block. The first chunk of every block
+      // links the blocks for the final release.
+      std::byte* const memory = static_cast<std::byte*>(
+         ::operator new( ( batchSize+1U )*chunkSize, std::align_val_t{ alignment } ) );
+
+      Node* const block = reinterpret_cast<Node*>( memory );
+      push( blocks_, block, block );
+
+      for( size_t i=1U; i<=batchSize; ++i ) {
+         Node* const node = reinterpret_cast<Node*>( memory + i*chunkSize );
+         node->next = ( i < batchSize ) ? reinterpret_cast<Node*>( memory + (i+1U)*chunkSize )
+                                        : nullptr;
+      }
+
+      cache.head  = reinterpret_cast<Node*>( memory + chunkSize );
+      cache.count = batchSize;
+   }
+
+   std::atomic<Node*> free_  { nullptr };
+   std::atomic<Node*> blocks_{ nullptr };
+
+   static thread_local Cache cache_;
+};
+
+template< size_t Size, size_t Alignment >
+thread_local typename FixedSizePool<Size,Alignment>::Cache FixedSizePool<Size,Alignment>::cache_{};
+
+
+
+
+// Deleter returning an object to the pool of its size class. Note that the size class is
+// determined by 'T', i.e. converting to a base class pointer requires both types to have the
+// same size and alignment.
+template< typename T >
+struct pool_delete
+{
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         ptr->~T();
+         FixedSizePool<sizeof(T),alignof(T)>::instance().deallocate(
+            const_cast<std::remove_cv_t<T>*>( ptr ) );
+      }
+   }
+};
+
+template< typename T >
+using pool_ptr = unique_ptr< T, pool_delete<T> >;
+
+
+// The free 'make_pooled()' function, the pool-based counterpart of 'make_unique()'
+template< typename T, typename... Ts >
+pool_ptr<T> make_pooled( Ts&&... params )
+{
+   auto& pool = FixedSizePool<sizeof(T),alignof(T)>::instance();
+   void* const memory = pool.allocate();
+
+   try {
+      return pool_ptr<T>( ::new (memory) T( std::forward<Ts>( params )... ) );
+   }
+   catch( ... ) {
+      pool.deallocate( memory );
+      throw;
+   }
+}
+
+
+
+
+// Stateful deleter returning an object to the memory resource it has been allocated from, e.g.
+// a 'std::pmr::synchronized_pool_resource'. In contrast to 'pool_delete', every unique_ptr has
+// to store the deleter, i.e. the pointer to the memory resource.
+template< typename T >
+struct resource_delete
+{
+   std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         ptr->~T();
+         resource->deallocate( const_cast<std::remove_cv_t<T>*>( ptr ), sizeof(T), alignof(T) );
+      }
+   }
+};
+
+// The array deleter additionally needs the number of elements to destroy and to deallocate
+template< typename T >
+struct resource_delete<T[]>
+{
+   std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };
+   size_t size{ 0U };
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         std::destroy_n( ptr, size );
+         resource->deallocate( const_cast<std::remove_cv_t<T>*>( ptr ), size*sizeof(T), alignof(T) );
+      }
+   }
+};
+
+
+// The free 'allocate_unique()' functions, creating an object or an array of default initialized
+// objects within the given memory resource
+template< typename T, typename... Ts >
+   requires ( !std::is_array_v<T> )
+unique_ptr< T, resource_delete<T> > allocate_unique( std::pmr::memory_resource& resource, Ts&&... params )
+{
+   void* const memory = resource.allocate( sizeof(T), alignof(T) );
+
+   try {
+      return unique_ptr< T, resource_delete<T> >(
+         ::new (memory) T( std::forward<Ts>( params )... ), resource_delete<T>{ &resource } );
+   }
+   catch( ... ) {
+      resource.deallocate( memory, sizeof(T), alignof(T) );
+      throw;
+   }
+}
+
+template< typename T >
+   requires std::is_unbounded_array_v<T>
+unique_ptr< T, resource_delete<T> > allocate_unique( std::pmr::memory_resource& resource, size_t size )
+{
+   using U = std::remove_extent_t<T>;
+
+   void* const memory = resource.allocate( size*sizeof(U), alignof(U) );
+
+   try {
+      U* const ptr = static_cast<U*>( memory );
+      std::uninitialized_default_construct_n( ptr, size );
+      return unique_ptr< T, resource_delete<T> >( ptr, resource_delete<T>{ &resource, size } );
+   }
+   catch( ... ) {
+      resource.deallocate( memory, size*sizeof(U), alignof(U) );
+      throw;
+   }
+}
+
+
+// Stateless deleters don't increase the size of a unique_ptr, stateful deleters are stored
+// in addition to the pointer
+static_assert( sizeof( unique_ptr<int>   ) == sizeof(int*) );
+static_assert( sizeof( unique_ptr<int[]> ) == sizeof(int*) );
+static_assert( sizeof( pool_ptr<int>     ) == sizeof(int*) );
+static_assert( sizeof( unique_ptr< int, resource_delete<int> > ) == 2U*sizeof(int*) );
+
+
+
+
+//---- <Reclaimer.h> ------------------------------------------------------------------------------
+
+// Deferred destruction of objects by a background thread. Every thread collects retired objects
+// in a thread-local batch. Full batches are published to the thread's own lock-free retire queue,
+// which is drained by the reclaimer thread. Since the reclaimer always takes the entire queue,
+// the queue is not affected by the ABA problem of lock-free stacks.
+class Reclaimer
+{
+ public:
+   static Reclaimer& instance()
+   {
+      static Reclaimer reclaimer{};
+      return reclaimer;
+   }
+
+   Reclaimer( Reclaimer const& ) = delete;
+   Reclaimer& operator=( Reclaimer const& ) = delete;
+
+   ~Reclaimer()
+   {
+      done_.store( true );
+      signal();
+      thread_.join();
+
+      for( Queue* queue : queues_ ) {
+         delete queue;
+      }
+   }
+
+   // Hands the given object over to the reclaimer thread
+   template< typename T >
+   void retire( T* ptr ) noexcept
+   {
+      void* const object = const_cast<void*>( static_cast<void const*>( ptr ) );
+      Destroy const destroy = []( void* p ) noexcept { delete static_cast<T*>( p ); };
+
+      Local& local = local_;
+
+      if( !local.batch ) {
+         local.batch = new (std::nothrow) Batch{};
+         if( !local.batch ) {
+            destroy( object );  // Synchronous destruction as fallback
+            return;
+         }
+      }
+
+      local.batch->items[local.batch->count++] = Item{ object, destroy };
+
+      if( local.batch->count == Batch::capacity ) {
+         publish( local );
+      }
+   }
+
+   // Publishes the objects retired by the calling thread, which are not yet part of a full batch
+   void flush() noexcept
+   {
+      Local& local = local_;
+      if( local.batch ) {
+         publish( local );
+      }
+   }
+
+   // Blocks until all objects retired by the calling thread and all objects published by other
+   // threads before the call have been destroyed
+   void quiesce() noexcept
+   {
+      flush();
+
+      // All batches published so far are taken by the first drain pass, which begins after this
+      // point. Waiting for a global number of reclaimed objects would not suffice, since a pass
+      // might already have visited the queue of this thread before the flush.
+      size_t const target = passes_begun_.load() + 1U;
+      signal();
+
+      size_t completed = passes_completed_.load( std::memory_order_acquire );
+      while( completed < target ) {
+         passes_completed_.wait( completed, std::memory_order_acquire );
+         completed = passes_completed_.load( std::memory_order_acquire );
+      }
+   }
+
+ private:
+   using Destroy = void(*)( void* ) noexcept;
+
+   struct Item
+   {
+      void*   object;
+      Destroy destroy;
+   };
+
+   struct Batch
+   {
+      static constexpr size_t capacity = 64U;
+
+      Batch* next{ nullptr };
+      size_t count{ 0U };
+      Item   items[capacity];
+   };
+
+   struct Queue
+   {
+      std::atomic<Batch*> head     { nullptr };
+      std::atomic<bool>   abandoned{ false };
+   };
+
+   // Thread-local state: The current batch and the retire queue of the thread. At thread exit,
+   // the remaining objects are published and the queue is left to the reclaimer.
+   struct Local
+   {
+      ~Local()
+      {
+         if( batch ) {
+            instance().publish( *this );
+         }
+         if( queue ) {
+            queue->abandoned.store( true, std::memory_order_release );
+         }
+      }
+
+      Queue* queue{ nullptr };
+      Batch* batch{ nullptr };
+   };
+
+   Reclaimer()
+      : thread_( [this]{ run(); } )
+   {}
+
+   void publish( Local& local ) noexcept
+   {
+      Batch* const batch = std::exchange( local.batch, nullptr );
+      size_t const count = batch->count;
+
+      if( !local.queue && !register_queue( local ) ) {
+         // Synchronous destruction as fallback
+         for( size_t i=0U; i<count; ++i ) {
+            batch->items[i].destroy( batch->items[i].object );
+         }
+         delete batch;
+         return;
+      }
+
+      // Single producer: Only the owning thread pushes, the reclaimer only takes all batches. The
+      // push is sequentially consistent to be ordered with the pass counter read by 'quiesce()'.
+      batch->next = local.queue->head.load( std::memory_order_relaxed );
+      while( !local.queue->head.compare_exchange_weak( batch->next, batch ) ) {}
+
+      published_.fetch_add( count, std::memory_order_release );
+      signal();
+   }
+
+   bool register_queue( Local& local ) noexcept
+   {
+      Queue* const queue = new (std::nothrow) Queue{};
+      if( !queue ) return false;
+
+      try {
+         std::scoped_lock lock( mutex_ );
+         queues_.push_back( queue );
+      }
+      catch( ... ) {
+         delete queue;
+         return false;
+      }
+
+      local.queue = queue;
+      return true;
+   }
+
+   void signal() noexcept
+   {
+      signal_.fetch_add( 1U, std::memory_order_release );
+      signal_.notify_one();
+   }
+
+   void run()
+   {
+      size_t seen{ 0U };
+      while( true ) {
+         signal_.wait( seen, std::memory_order_acquire );
+         seen = signal_.load( std::memory_order_acquire );
+
+         bool const done = done_.load();
+
+         // Objects retired by the destructors of reclaimed objects are published immediately
+         do {
+            drain();
+            flush();
+         } while( done && reclaimed_.load() < published_.load() );
+
+         if( done ) return;
+      }
+   }
+
+   void drain()
+   {
+      size_t const pass = passes_begun_.fetch_add( 1U ) + 1U;
+
+      std::vector<Queue*> queues;
+      {
+         std::scoped_lock lock( mutex_ );
+         queues = queues_;
+      }
+
+      size_t count{ 0U };
+
+      for( Queue* const queue : queues )
+      {
+         bool const abandoned = queue->abandoned.load( std::memory_order_acquire );
+         Batch* batch = queue->head.exchange( nullptr );
+
+         // The batches are reversed to destroy the objects in the order of their retirement
+         Batch* fifo{ nullptr };
+         while( batch ) {
+            Batch* const next = batch->next;
+            batch->next = fifo;
+            fifo = batch;
+            batch = next;
+         }
+
+         while( fifo ) {
+            for( size_t i=0U; i<fifo->count; ++i ) {
+               fifo->items[i].destroy( fifo->items[i].object );
+            }
+            count += fifo->count;
+            delete std::exchange( fifo, fifo->next );
+         }
+
+         if( abandoned ) {
+            std::scoped_lock lock( mutex_ );
+            queues_.erase( std::find( queues_.begin(), queues_.end(), queue ) );
+            delete queue;
+         }
+      }
+
+      if( count > 0U ) {
+         reclaimed_.fetch_add( count, std::memory_order_release );
+      }
+
+      passes_completed_.store( pass, std::memory_order_release );
+      passes_completed_.notify_all();
+   }
+
+   std::mutex          mutex_;
+   std::vector<Queue*> queues_;
+
+   std::atomic<size_t> signal_   { 0U };
+   std::atomic<size_t> published_{ 0U };
+   std::atomic<size_t> reclaimed_{ 0U };
+   std::atomic<size_t> passes_begun_    { 0U };  // Number of started drain passes
+   std::atomic<size_t> passes_completed_{ 0U };  // Number of finished drain passes
+   std::atomic<bool>   done_     { false };
+
+   std::thread thread_;
+
+   static thread_local Local local_;
+};
+
+inline thread_local Reclaimer::Local Reclaimer::local_{};
+
+
+
+
+// Deleter handing an object over to the reclaimer thread, which takes the destruction of large
+// object graphs off the latency-critical path of the calling thread
+template< typename T >
+struct deferred_delete
+{
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         Reclaimer::instance().retire( ptr );
+      }
+   }
+};
+
+template< typename T >
+using deferred_ptr = unique_ptr< T, deferred_delete<T> >;
+
+static_assert( sizeof( deferred_ptr<int> ) == sizeof(int*) );
+
+
+
+
 //---- <Main.cpp> ---------------------------------------------------------------------------------
 
 template< typename T >
@@ -326,6 +951,61 @@ void transfer_ownership( unique_ptr<T> a )
 }
 
 
+// Time in milliseconds for 'threads' threads to each create 'iterations' objects, while keeping
+// a sliding window of live objects
+template< typename Factory >
+double churn( Factory factory, size_t threads, size_t iterations )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   {
+      std::vector<std::thread> workers;
+      for( size_t t=0U; t<threads; ++t ) {
+         workers.emplace_back( [&factory,iterations]() {
+            std::vector< decltype( factory( 0 ) ) > window( 64U );
+            for( size_t i=0U; i<iterations; ++i ) {
+               window[i % window.size()] = factory( static_cast<int>( i ) );
+            }
+         } );
+      }
+      for( auto& worker : workers ) {
+         worker.join();
+      }
+   }
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
+// Latencies in microseconds of 'reset()' calls for a workload of mostly small and occasionally
+// large object graphs
+template< typename Ptr >
+std::vector<double> reset_latencies( size_t iterations )
+{
+   using Clock = std::chrono::steady_clock;
+   using Graph = std::list< std::vector<int> >;
+
+   std::vector<double> latencies;
+   latencies.reserve( iterations );
+
+   for( size_t i=0U; i<iterations; ++i )
+   {
+      Ptr graph( new Graph( ( i % 50U == 0U ) ? 20000U : 16U, std::vector<int>( 4U ) ) );
+
+      auto const start = Clock::now();
+      graph.reset();
+      std::chrono::duration<double,std::micro> const time = Clock::now() - start;
+
+      latencies.push_back( time.count() );
+   }
+
+   std::sort( latencies.begin(), latencies.end() );
+   return latencies;
+}
+
+
 int main()
 {
    // unique_ptr for a single Widget
@@ -389,5 +1069,87 @@ int main()
       std::cout << " b has been moved to a (a=[" << a[0].get() << "," << a[1].get() << "," << a[2].get() << "])\n\n";
    }
 
+   // unique_ptr for a pool allocated Widget
+   {
+      pool_ptr<Widget> a = make_pooled<Widget>( 6 );
+      std::cout << " a has been created (a=" << a->get() << ")\n\n";
+
+      a = make_pooled<Widget>( 7 );
+      std::cout << " a has been reassigned (a=" << a->get() << ")\n\n";
+   }
+
+   // unique_ptr with a stateful deleter for a single Widget and an array of Widgets
+   {
+      std::pmr::unsynchronized_pool_resource resource{};
+
+      auto a = allocate_unique<Widget>( resource, 8 );
+      std::cout << " a has been created (a=" << a->get() << ")\n\n";
+
+      auto b = allocate_unique<Widget[]>( resource, 2U );
+      b[0].set( 9 );
+      b[1].set( 10 );
+      std::cout << " b has been created (b=[" << b[0].get() << "," << b[1].get() << "])\n\n";
+
+      auto c( std::move(b) );
+      std::cout << " b has been moved to c (deleter: size=" << c.get_deleter().size << ")\n\n";
+   }
+
+   // unique_ptr with deferred destruction
+   {
+      deferred_ptr<Widget> a( new Widget( 11 ) );
+      std::cout << " a has been created (a=" << a->get() << ")\n\n";
+
+      a.reset();
+      Reclaimer::instance().quiesce();
+      std::cout << " a has been reset and reclaimed\n\n";
+   }
+
+   // Comparison of the reset latency of immediate and deferred destruction
+   {
+      using Graph = std::list< std::vector<int> >;
+
+      constexpr size_t iterations( 10000U );
+
+      auto const percentile = []( std::vector<double> const& latencies, double p ) {
+         return latencies[ static_cast<size_t>( p * static_cast<double>( latencies.size()-1U ) ) ];
+      };
+
+      std::cout << " reset() latency         p50         p99         max\n";
+      for( int deferred : { 0, 1 } )
+      {
+         std::vector<double> const latencies =
+            deferred ? reset_latencies< deferred_ptr<Graph> >( iterations )
+                     : reset_latencies< unique_ptr<Graph>   >( iterations );
+         Reclaimer::instance().quiesce();
+
+         std::cout << ( deferred ? " deferred_delete " : " default_delete  " )
+                   << std::setw(9) << percentile( latencies, 0.5  ) << " us"
+                   << std::setw(9) << percentile( latencies, 0.99 ) << " us"
+                   << std::setw(9) << latencies.back() << " us\n";
+      }
+      std::cout << "\n";
+   }
+
+   // Comparison of new/delete, the pool and a pool resource for a multi-threaded allocation churn
+   {
+      constexpr size_t iterations( 1000000U );
+
+      std::pmr::synchronized_pool_resource resource{};
+
+      std::cout << " Threads    new/delete          pool     pmr::pool\n";
+      for( size_t threads : { 1U, 2U, 4U, 8U } ) {
+         double const t1 = churn( []( int i ){ return make_unique<int>( i ); }, threads, iterations );
+         double const t2 = churn( []( int i ){ return make_pooled<int>( i ); }, threads, iterations );
+         double const t3 = churn( [&resource]( int i ){ return allocate_unique<int>( resource, i ); }
+                                , threads, iterations );
+
+         std::cout << std::setw(8)  << threads
+                   << std::setw(11) << t1 << " ms"
+                   << std::setw(11) << t2 << " ms"
+                   << std::setw(11) << t3 << " ms\n";
+      }
+      std::cout << "\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -13,10 +13,13 @@
 **************************************************************************************************/
 
 #include <algorithm>
+#include <cassert>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 
 using std::size_t;
 using namespace std::string_literals;
@@ -52,9 +55,12 @@ class Vector
  public:
    using iterator       = Type*;
    using const_iterator = const Type*;
+   using allocator_type = Allocator;
 
    Vector() = default;
+   explicit Vector( const Allocator& alloc );
    Vector( const Vector& sv );
+   Vector( const Vector& sv, const Allocator& alloc );
    Vector( Vector&& sv );
 
    Vector& operator=( const Vector& sv );
@@ -68,6 +74,8 @@ class Vector
    size_t size() const;
    size_t capacity() const;
 
+   allocator_type get_allocator() const;
+
    Type&       operator[]( size_t index );
    const Type& operator[]( size_t index ) const;
 
@@ -79,23 +87,36 @@ class Vector
    void swap( Vector& sv );
 
  private:
+   using AllocTraits = std::allocator_traits<Allocator>;
+
    void reallocate();
    void free();
 
+   // Per-instance allocator; stateless allocators don't occupy any storage
+   [[no_unique_address]] Allocator alloc_{};
+
    Type* begin_{ nullptr };
    Type* end_  { nullptr };
    Type* final_{ nullptr };
-
-   static Allocator alloc;
 };
 
+
 template< typename Type, typename Allocator >
-Allocator Vector<Type,Allocator>::alloc;
+Vector<Type,Allocator>::Vector( const Allocator& alloc )
+   : alloc_( alloc )
+{}
 
 
 template< typename Type, typename Allocator >
 Vector<Type,Allocator>::Vector( const Vector& sv )
-   : begin_( alloc.allocate( sv.size() ) )
+   : Vector( sv, AllocTraits::select_on_container_copy_construction( sv.alloc_ ) )
+{}
+
+
+template< typename Type, typename Allocator >
+Vector<Type,Allocator>::Vector( const Vector& sv, const Allocator& alloc )
+   : alloc_( alloc )
+   , begin_( AllocTraits::allocate( alloc_, sv.size() ) )
    , end_  ( std::uninitialized_copy( sv.begin(), sv.end(), begin_ ) )
    , final_( end_ )
 {}
@@ -103,7 +124,8 @@ Vector<Type,Allocator>::Vector( const Vector& sv )
 
 template< typename Type, typename Allocator >
 Vector<Type,Allocator>::Vector( Vector&& sv )
-   : begin_( sv.begin_ )
+   : alloc_( std::move(sv.alloc_) )
+   , begin_( sv.begin_ )
    , end_  ( sv.end_   )
    , final_( sv.final_ )
 {
@@ -116,8 +138,20 @@ Vector<Type,Allocator>::Vector( Vector&& sv )
 template< typename Type, typename Allocator >
 Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( const Vector& sv )
 {
-   Vector tmp( sv );
-   swap( tmp );
+   constexpr bool propagate( AllocTraits::propagate_on_container_copy_assignment::value );
+
+   Vector tmp( sv, propagate ? sv.alloc_ : alloc_ );
+
+   using std::swap;
+
+   if constexpr( propagate ) {
+      swap( alloc_, tmp.alloc_ );
+   }
+
+   swap( begin_, tmp.begin_ );
+   swap( end_  , tmp.end_   );
+   swap( final_, tmp.final_ );
+
    return *this;
 }
 
@@ -125,8 +159,28 @@ Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( const Vector& sv )
 template< typename Type, typename Allocator >
 Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( Vector&& sv )
 {
+   constexpr bool propagate( AllocTraits::propagate_on_container_move_assignment::value );
+
+   // Memory of a different, non-propagating allocator cannot be adopted and requires to move
+   // the elements one by one
+   if constexpr( !propagate && !AllocTraits::is_always_equal::value ) {
+      if( alloc_ != sv.alloc_ ) {
+         Vector tmp( alloc_ );
+         tmp.begin_ = AllocTraits::allocate( tmp.alloc_, sv.size() );
+         tmp.end_   = tmp.begin_;
+         tmp.final_ = tmp.begin_ + sv.size();
+         tmp.end_   = std::uninitialized_move( sv.begin_, sv.end_, tmp.begin_ );
+         swap( tmp );
+         return *this;
+      }
+   }
+
    free();
 
+   if constexpr( propagate ) {
+      alloc_ = std::move(sv.alloc_);
+   }
+
    begin_ = sv.begin_;
    end_   = sv.end_;
    final_ = sv.final_;
@@ -142,7 +196,7 @@ Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( Vector&& sv )
 template< typename Type, typename Allocator >
 Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( std::initializer_list<Type> list )
 {
-   Vector tmp;
+   Vector tmp( alloc_ );
    for( const Type& s : list ) {
       tmp.push_back( s );
    }
@@ -196,6 +250,13 @@ size_t Vector<Type,Allocator>::capacity() const
 }
 
 
+template< typename Type, typename Allocator >
+typename Vector<Type,Allocator>::allocator_type Vector<Type,Allocator>::get_allocator() const
+{
+   return alloc_;
+}
+
+
 template< typename Type, typename Allocator >
 Type& Vector<Type,Allocator>::operator[]( size_t index )
 {
@@ -240,6 +301,14 @@ void Vector<Type,Allocator>::swap( Vector& sv )
 {
    using std::swap;
 
+   if constexpr( AllocTraits::propagate_on_container_swap::value ) {
+      swap( alloc_, sv.alloc_ );
+   }
+   else {
+      // Swapping two vectors with unequal, non-propagating allocators is undefined behavior
+      assert( alloc_ == sv.alloc_ );
+   }
+
    swap( begin_, sv.begin_ );
    swap( end_  , sv.end_   );
    swap( final_, sv.final_ );
@@ -251,7 +320,7 @@ void Vector<Type,Allocator>::reallocate()
 {
    const size_t n = ( size() ? 2*size() : 1UL );
 
-   auto newbegin( alloc.allocate( n ) );
+   auto newbegin( AllocTraits::allocate( alloc_, n ) );
    auto newend  ( std::uninitialized_copy( begin_, end_, newbegin ) );
 
    free();
@@ -266,7 +335,9 @@ template< typename Type, typename Allocator >
 void Vector<Type,Allocator>::free()
 {
    ::destroy( begin_, end_ );  // or since C++17 std::destroy()
-   alloc.deallocate( begin_, capacity() );
+   if( begin_ ) {
+      AllocTraits::deallocate( alloc_, begin_, capacity() );
+   }
 }
 
 
@@ -300,5 +371,20 @@ int main()
 
    std::cout << "\n" << sv2 << "\n\n";
 
+   // Stateless allocators don't increase the size of a vector
+   static_assert( sizeof(Vector<std::string>) == 3UL*sizeof(std::string*) );
+
+   // Vector with a stateful, per-instance allocator
+   {
+      std::byte buffer[1024];
+      std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer) );
+
+      Vector< std::string, std::pmr::polymorphic_allocator<std::string> > v( &arena );
+      v.push_back( "Scott"s );
+      v.push_back( "Kate"s );
+
+      std::cout << "\n" << v << "\n\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -13,10 +13,18 @@
 **************************************************************************************************/
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Arena.h"
 
 using std::size_t;
 using namespace std::string_literals;
@@ -46,15 +54,99 @@ constexpr void destroy( ForwardIt first, ForwardIt last )
 }
 
 
-template< typename Type, typename Allocator = std::allocator<Type> >
+// Customization point for types that can be relocated by a plain 'memcpy()' of their bytes,
+// i.e. for which a move construction followed by the destruction of the source is equivalent
+// to copying the object representation. This holds for all trivially copyable types, but
+// may be declared for other types (e.g. types holding a single owning pointer) by means of
+// a specialization.
+template< typename T >
+struct is_trivially_relocatable
+   : public std::is_trivially_copyable<T>
+{};
+
+template< typename T >
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+// Relocates the elements in the range [first,last) into the uninitialized memory starting at
+// 'dest'. After the call, the source range does not contain any live objects anymore. Elements
+// are memcpy'ed if they are trivially relocatable, moved if their move constructor cannot
+// throw, and copied otherwise. In case a copy throws, the source range remains untouched.
+template< typename T >
+T* uninitialized_relocate( T* first, T* last, T* dest )
+{
+   if constexpr( is_trivially_relocatable_v<T> ) {
+      if( first != last ) {
+         std::memcpy( static_cast<void*>( dest ), static_cast<const void*>( first )
+                    , static_cast<size_t>( last - first ) * sizeof(T) );
+      }
+      return dest + ( last - first );
+   }
+   else if constexpr( std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T> ) {
+      T* const result = std::uninitialized_move( first, last, dest );
+      ::destroy( first, last );
+      return result;
+   }
+   else {
+      T* const result = std::uninitialized_copy( first, last, dest );
+      ::destroy( first, last );
+      return result;
+   }
+}
+
+
+// Geometric growth by the factor 'Num/Den'. The first allocation holds a cache line worth of
+// elements (but at least one element) to avoid a series of tiny reallocations.
+template< size_t Num, size_t Den >
+struct GeometricGrowth
+{
+   static_assert( Num > Den, "The growth factor must be larger than 1" );
+
+   constexpr size_t operator()( size_t capacity, size_t elementSize ) const noexcept
+   {
+      if( capacity == 0UL ) {
+         return std::max( 64UL / elementSize, 1UL );
+      }
+      return std::max( capacity * Num / Den, capacity + 1UL );
+   }
+};
+
+using DoublingGrowth   = GeometricGrowth<2UL,1UL>;
+using OneAndHalfGrowth = GeometricGrowth<3UL,2UL>;
+
+
+// Growth by the factor 1.5, where allocations of at least one page are rounded up to a
+// multiple of the page size. This avoids partially used pages at the end of large buffers.
+template< size_t PageSize = 4096UL >
+struct PageRoundedGrowth
+{
+   constexpr size_t operator()( size_t capacity, size_t elementSize ) const noexcept
+   {
+      const size_t bytes( OneAndHalfGrowth{}( capacity, elementSize ) * elementSize );
+
+      if( bytes < PageSize ) {
+         return bytes / elementSize;
+      }
+      return ( bytes + PageSize - 1UL ) / PageSize * PageSize / elementSize;
+   }
+};
+
+
+template< typename Type
+        , typename Allocator = std::allocator<Type>
+        , typename GrowthPolicy = DoublingGrowth >
 class Vector
 {
  public:
    using iterator       = Type*;
    using const_iterator = const Type*;
+   using allocator_type = Allocator;
 
    Vector() = default;
+   explicit Vector( const Allocator& alloc );
    Vector( const Vector& sv );
+   Vector( const Vector& sv, const Allocator& alloc );
    Vector( Vector&& sv );
 
    Vector& operator=( const Vector& sv );
@@ -72,6 +164,11 @@ class Vector
    size_t size() const;
    size_t capacity() const;
 
+   void reserve( size_t n );
+   void shrink_to_fit();
+
+   allocator_type get_allocator() const;
+
    Type&       operator[]( size_t index );
    const Type& operator[]( size_t index ) const;
 
@@ -83,31 +180,45 @@ class Vector
    void swap( Vector& sv );
 
  private:
-   void reallocate();
+   using AllocTraits = std::allocator_traits<Allocator>;
+
+   void reallocate( size_t n );
    void free();
 
+   // Per-instance allocator; stateless allocators don't occupy any storage
+   [[no_unique_address]] Allocator alloc_{};
+
    Type* begin_{ nullptr };
    Type* end_  { nullptr };
    Type* final_{ nullptr };
-
-   static Allocator alloc;
 };
 
-template< typename Type, typename Allocator >
-Allocator Vector<Type,Allocator>::alloc;
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Allocator& alloc )
+   : alloc_( alloc )
+{}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Vector& sv )
+   : Vector( sv, AllocTraits::select_on_container_copy_construction( sv.alloc_ ) )
+{}
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>::Vector( const Vector& sv )
-   : begin_( alloc.allocate( sv.size() ) )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( const Vector& sv, const Allocator& alloc )
+   : alloc_( alloc )
+   , begin_( AllocTraits::allocate( alloc_, sv.size() ) )
    , end_  ( std::uninitialized_copy( sv.begin(), sv.end(), begin_ ) )
    , final_( end_ )
 {}
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>::Vector( Vector&& sv )
-   : begin_( sv.begin_ )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::Vector( Vector&& sv )
+   : alloc_( std::move(sv.alloc_) )
+   , begin_( sv.begin_ )
    , end_  ( sv.end_   )
    , final_( sv.final_ )
 {
@@ -117,20 +228,54 @@ Vector<Type,Allocator>::Vector( Vector&& sv )
 }
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( const Vector& sv )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( const Vector& sv )
 {
-   Vector tmp( sv );
-   swap( tmp );
+   constexpr bool propagate( AllocTraits::propagate_on_container_copy_assignment::value );
+
+   Vector tmp( sv, propagate ? sv.alloc_ : alloc_ );
+
+   using std::swap;
+
+   if constexpr( propagate ) {
+      swap( alloc_, tmp.alloc_ );
+   }
+
+   swap( begin_, tmp.begin_ );
+   swap( end_  , tmp.end_   );
+   swap( final_, tmp.final_ );
+
    return *this;
 }
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( Vector&& sv )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( Vector&& sv )
 {
+   constexpr bool propagate( AllocTraits::propagate_on_container_move_assignment::value );
+
+   // Memory of a different, non-propagating allocator cannot be adopted and requires to move
+   // the elements one by one
+   if constexpr( !propagate && !AllocTraits::is_always_equal::value ) {
+      if( alloc_ != sv.alloc_ ) {
+         Vector tmp( alloc_ );
+         tmp.begin_ = AllocTraits::allocate( tmp.alloc_, sv.size() );
+         tmp.end_   = tmp.begin_;
+         tmp.final_ = tmp.begin_ + sv.size();
+         tmp.end_   = std::uninitialized_move( sv.begin_, sv.end_, tmp.begin_ );
+         swap( tmp );
+         return *this;
+      }
+   }
+
    free();
 
+   if constexpr( propagate ) {
+      alloc_ = std::move(sv.alloc_);
+   }
+
    begin_ = sv.begin_;
    end_   = sv.end_;
    final_ = sv.final_;
@@ -143,10 +288,11 @@ Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( Vector&& sv )
 }
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( std::initializer_list<Type> list )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>&
+   Vector<Type,Allocator,GrowthPolicy>::operator=( std::initializer_list<Type> list )
 {
-   Vector tmp;
+   Vector tmp( alloc_ );
    for( const Type& s : list ) {
       tmp.push_back( s );
    }
@@ -155,18 +301,18 @@ Vector<Type,Allocator>& Vector<Type,Allocator>::operator=( std::initializer_list
 }
 
 
-template< typename Type, typename Allocator >
-Vector<Type,Allocator>::~Vector()
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Vector<Type,Allocator,GrowthPolicy>::~Vector()
 {
    free();
 }
 
 
-template< typename Type, typename Allocator >
-void Vector<Type,Allocator>::push_back( const Type& v )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::push_back( const Type& v )
 {
    if( end_ == final_ ) {
-      reallocate();
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
    }
 
    ::construct_at( end_, v );  // or since C++20 std::construct_at
@@ -174,11 +320,11 @@ void Vector<Type,Allocator>::push_back( const Type& v )
 }
 
 
-template< typename Type, typename Allocator >
-void Vector<Type,Allocator>::push_back( Type&& v )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::push_back( Type&& v )
 {
    if( end_ == final_ ) {
-      reallocate();
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
    }
 
    ::construct_at( end_, std::move(v) );  // or since C++20 std::construct_at
@@ -186,12 +332,12 @@ void Vector<Type,Allocator>::push_back( Type&& v )
 }
 
 
-template< typename Type, typename Allocator >
+template< typename Type, typename Allocator, typename GrowthPolicy >
 template< typename... Args >
-void Vector<Type,Allocator>::emplace_back( Args&&... args )
+void Vector<Type,Allocator,GrowthPolicy>::emplace_back( Args&&... args )
 {
    if( end_ == final_ ) {
-      reallocate();
+      reallocate( GrowthPolicy{}( capacity(), sizeof(Type) ) );
    }
 
    ::construct_at( end_, std::forward<Args>(args)... );  // or since C++20 std::construct_at
@@ -199,79 +345,126 @@ void Vector<Type,Allocator>::emplace_back( Args&&... args )
 }
 
 
-template< typename Type, typename Allocator >
-size_t Vector<Type,Allocator>::size() const
+template< typename Type, typename Allocator, typename GrowthPolicy >
+size_t Vector<Type,Allocator,GrowthPolicy>::size() const
 {
    return end_ - begin_;
 }
 
 
-template< typename Type, typename Allocator >
-size_t Vector<Type,Allocator>::capacity() const
+template< typename Type, typename Allocator, typename GrowthPolicy >
+size_t Vector<Type,Allocator,GrowthPolicy>::capacity() const
 {
    return final_ - begin_;
 }
 
 
-template< typename Type, typename Allocator >
-Type& Vector<Type,Allocator>::operator[]( size_t index )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::reserve( size_t n )
+{
+   if( n > capacity() ) {
+      reallocate( n );
+   }
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::shrink_to_fit()
+{
+   if( capacity() > size() ) {
+      reallocate( size() );
+   }
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::allocator_type
+   Vector<Type,Allocator,GrowthPolicy>::get_allocator() const
+{
+   return alloc_;
+}
+
+
+template< typename Type, typename Allocator, typename GrowthPolicy >
+Type& Vector<Type,Allocator,GrowthPolicy>::operator[]( size_t index )
 {
    return begin_[index];
 }
 
 
-template< typename Type, typename Allocator >
-const Type& Vector<Type,Allocator>::operator[]( size_t index ) const
+template< typename Type, typename Allocator, typename GrowthPolicy >
+const Type& Vector<Type,Allocator,GrowthPolicy>::operator[]( size_t index ) const
 {
    return begin_[index];
 }
 
 
-template< typename Type, typename Allocator >
-typename Vector<Type,Allocator>::iterator Vector<Type,Allocator>::begin()
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::iterator
+   Vector<Type,Allocator,GrowthPolicy>::begin()
 {
    return begin_;
 }
 
-template< typename Type, typename Allocator >
-typename Vector<Type,Allocator>::iterator Vector<Type,Allocator>::end()
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::iterator
+   Vector<Type,Allocator,GrowthPolicy>::end()
 {
    return end_;
 }
 
-template< typename Type, typename Allocator >
-typename Vector<Type,Allocator>::const_iterator Vector<Type,Allocator>::begin() const
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::const_iterator
+   Vector<Type,Allocator,GrowthPolicy>::begin() const
 {
    return begin_;
 }
 
-template< typename Type, typename Allocator >
-typename Vector<Type,Allocator>::const_iterator Vector<Type,Allocator>::end() const
+template< typename Type, typename Allocator, typename GrowthPolicy >
+typename Vector<Type,Allocator,GrowthPolicy>::const_iterator
+   Vector<Type,Allocator,GrowthPolicy>::end() const
 {
    return end_;
 }
 
 
-template< typename Type, typename Allocator >
-void Vector<Type,Allocator>::swap( Vector& sv )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::swap( Vector& sv )
 {
    using std::swap;
 
+   if constexpr( AllocTraits::propagate_on_container_swap::value ) {
+      swap( alloc_, sv.alloc_ );
+   }
+   else {
+      // Swapping two vectors with unequal, non-propagating allocators is undefined behavior
+      assert( alloc_ == sv.alloc_ );
+   }
+
    swap( begin_, sv.begin_ );
    swap( end_  , sv.end_   );
    swap( final_, sv.final_ );
 }
 
 
-template< typename Type, typename Allocator >
-void Vector<Type,Allocator>::reallocate()
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::reallocate( size_t n )
 {
-   const size_t n = ( size() ? 2*size() : 1UL );
+   auto newbegin( n ? AllocTraits::allocate( alloc_, n ) : nullptr );
+   Type* newend{};
 
-   auto newbegin( alloc.allocate( n ) );
-   auto newend  ( std::uninitialized_copy( begin_, end_, newbegin ) );
+   try {
+      newend = ::uninitialized_relocate( begin_, end_, newbegin );
+   }
+   catch( ... ) {
+      AllocTraits::deallocate( alloc_, newbegin, n );
+      throw;
+   }
 
-   free();
+   // The old elements have already been relocated, only the memory needs to be released
+   if( begin_ ) {
+      AllocTraits::deallocate( alloc_, begin_, capacity() );
+   }
 
    begin_ = newbegin;
    end_   = newend;
@@ -279,16 +472,18 @@ void Vector<Type,Allocator>::reallocate()
 }
 
 
-template< typename Type, typename Allocator >
-void Vector<Type,Allocator>::free()
+template< typename Type, typename Allocator, typename GrowthPolicy >
+void Vector<Type,Allocator,GrowthPolicy>::free()
 {
    ::destroy( begin_, end_ );  // or since C++17 std::destroy
-   alloc.deallocate( begin_, capacity() );
+   if( begin_ ) {
+      AllocTraits::deallocate( alloc_, begin_, capacity() );
+   }
 }
 
 
-template< typename Type, typename Allocator >
-std::ostream& operator<<( std::ostream& os, const Vector<Type,Allocator>& sv )
+template< typename Type, typename Allocator, typename GrowthPolicy >
+std::ostream& operator<<( std::ostream& os, const Vector<Type,Allocator,GrowthPolicy>& sv )
 {
    os << "(";
    for( const auto& s : sv ) {
@@ -298,6 +493,136 @@ std::ostream& operator<<( std::ostream& os, const Vector<Type,Allocator>& sv )
 }
 
 
+//---- <Benchmark> --------------------------------------------------------------------------------
+
+enum class Growth { copy, move, relocate };
+
+// Heap-owning string whose growth strategy within a 'Vector' is selected by 'G':
+//  - Growth::copy    : potentially throwing move constructor, i.e. elements are copied
+//  - Growth::move    : noexcept move constructor, i.e. elements are moved
+//  - Growth::relocate: declared trivially relocatable, i.e. elements are memcpy'ed
+template< Growth G >
+class BoxedString
+{
+ public:
+   explicit BoxedString( std::string s )
+      : ptr_( std::make_unique<std::string>( std::move(s) ) )
+   {}
+
+   BoxedString( const BoxedString& other )
+      : ptr_( std::make_unique<std::string>( *other.ptr_ ) )
+   {}
+
+   BoxedString( BoxedString&& other ) noexcept( G != Growth::copy )
+      : ptr_( std::move(other.ptr_) )
+   {}
+
+   const std::string& str() const { return *ptr_; }
+
+ private:
+   std::unique_ptr<std::string> ptr_;
+};
+
+template<>
+struct is_trivially_relocatable< BoxedString<Growth::relocate> >
+   : public std::true_type
+{};
+
+
+template< Growth G >
+void benchmark_growth( const char* label, size_t N, size_t repetitions )
+{
+   using Clock = std::chrono::steady_clock;
+
+   const std::string s( "A string that does not fit into the small string buffer" );
+   size_t checksum{};
+
+   const auto start = Clock::now();
+   for( size_t rep=0UL; rep<repetitions; ++rep ) {
+      Vector< BoxedString<G> > v;
+      for( size_t i=0UL; i<N; ++i ) {
+         v.emplace_back( s );
+      }
+      checksum += v[N-1UL].str().size();
+   }
+   const std::chrono::duration<double,std::milli> time = Clock::now() - start;
+
+   std::cout << " " << label << ": " << time.count() / repetitions << " ms"
+             << " (checksum " << checksum << ")\n";
+}
+
+
+// Allocator recording the number of allocations and the peak memory consumption
+struct AllocationStats
+{
+   size_t allocations{};
+   size_t bytes{};
+   size_t peak{};
+};
+
+template< typename T >
+class CountingAllocator
+{
+ public:
+   using value_type = T;
+
+   explicit CountingAllocator( AllocationStats* stats ) noexcept
+      : stats_( stats )
+   {}
+
+   template< typename U >
+   CountingAllocator( const CountingAllocator<U>& other ) noexcept
+      : stats_( other.stats_ )
+   {}
+
+   T* allocate( size_t n )
+   {
+      T* const ptr( std::allocator<T>{}.allocate( n ) );
+      ++stats_->allocations;
+      stats_->bytes += n*sizeof(T);
+      stats_->peak = std::max( stats_->peak, stats_->bytes );
+      return ptr;
+   }
+
+   void deallocate( T* ptr, size_t n ) noexcept
+   {
+      stats_->bytes -= n*sizeof(T);
+      std::allocator<T>{}.deallocate( ptr, n );
+   }
+
+   friend bool operator==( const CountingAllocator& lhs, const CountingAllocator& rhs ) = default;
+
+ private:
+   AllocationStats* stats_;
+
+   template< typename U > friend class CountingAllocator;
+};
+
+
+template< typename GrowthPolicy >
+void benchmark_growth_policy( const char* label, size_t N )
+{
+   using Clock = std::chrono::steady_clock;
+
+   AllocationStats stats{};
+
+   const auto start = Clock::now();
+   {
+      const CountingAllocator<int> alloc( &stats );
+      Vector< int, CountingAllocator<int>, GrowthPolicy > v( alloc );
+      for( size_t i=0UL; i<N; ++i ) {
+         v.push_back( static_cast<int>( i ) );
+      }
+      std::cout << " " << label << ": " << stats.allocations << " allocations"
+                << ", peak memory " << stats.peak / 1024UL << " KiB"
+                << ", final capacity " << v.capacity();
+   }
+   const std::chrono::duration<double,std::milli> time = Clock::now() - start;
+
+   std::cout << ", " << time.count() << " ms\n";
+}
+
+
 int main()
 {
    Vector<std::string> sv;
@@ -317,5 +642,66 @@ int main()
 
    std::cout << "\n" << sv2 << "\n\n";
 
+   // Stateless allocators don't increase the size of a vector
+   static_assert( sizeof(Vector<std::string>) == 3UL*sizeof(std::string*) );
+
+   // Vector with a stateful, per-instance allocator
+   {
+      std::byte buffer[1024];
+      std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer) );
+
+      Vector< std::string, std::pmr::polymorphic_allocator<std::string> > v( &arena );
+      v.push_back( "Scott"s );
+      v.push_back( "Kate"s );
+
+      std::cout << "\n" << v << "\n\n";
+   }
+
+   // Vector with elements living in an arena
+   {
+      Arena arena{};
+
+      Vector< std::string, ArenaAllocator<std::string> > v( arena );
+      v.emplace_back( "Andrei"s );
+      v.emplace_back( "Alexander"s );
+
+      std::cout << "\n" << v << "\n\n";
+   }
+
+   // Explicit control over the capacity
+   {
+      Vector<std::string> v;
+      v.reserve( 10UL );
+      v.push_back( "Jason"s );
+      v.push_back( "Ben"s );
+      std::cout << " Capacity after reserve(): " << v.capacity() << "\n";
+
+      v.shrink_to_fit();
+      std::cout << " Capacity after shrink_to_fit(): " << v.capacity() << "\n\n";
+   }
+
+   // Comparison of the growth strategies of 'reallocate()'
+   {
+      constexpr size_t N( 100000UL );
+      constexpr size_t repetitions( 10UL );
+
+      std::cout << " Growth benchmark (" << N << " push backs):\n";
+      benchmark_growth<Growth::copy>    ( "copy    ", N, repetitions );
+      benchmark_growth<Growth::move>    ( "move    ", N, repetitions );
+      benchmark_growth<Growth::relocate>( "relocate", N, repetitions );
+      std::cout << "\n";
+   }
+
+   // Comparison of the growth policies
+   {
+      constexpr size_t N( 1000000UL );
+
+      std::cout << " Growth policy benchmark (" << N << " push backs):\n";
+      benchmark_growth_policy<DoublingGrowth>     ( "2x          ", N );
+      benchmark_growth_policy<OneAndHalfGrowth>   ( "1.5x        ", N );
+      benchmark_growth_policy<PageRoundedGrowth<>>( "page-rounded", N );
+      std::cout << "\n";
+   }
+
    return EXIT_SUCCESS;
 }
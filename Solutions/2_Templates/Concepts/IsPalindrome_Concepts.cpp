@@ -19,12 +19,26 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#  include <immintrin.h>
+#  define PALINDROME_X86_DISPATCH 1
+#else
+#  define PALINDROME_X86_DISPATCH 0
+#endif
+
 
 // The 'bidirectional_iterator' concept
 /*
@@ -62,6 +76,170 @@ constexpr bool is_palindrome( BidirIt first, BidirIt last )
 }
 
 
+// Block-wise comparison for contiguous ranges: Instead of comparing one element per step, a
+// complete block of elements is loaded from the front and from the back of the range. After
+// reversing the order of the elements in the back block, both blocks are compared at once. This
+// requires elements whose equality is equivalent to the equality of their bytes.
+template< typename T >
+concept BitwiseComparable =
+   std::is_scalar_v<T> && std::has_unique_object_representations_v<T> &&
+   ( sizeof(T) == 1U || sizeof(T) == 2U || sizeof(T) == 4U || sizeof(T) == 8U );
+
+// Reverses the order of the elements of size 'S' within a 64-bit word
+template< std::size_t S >
+constexpr std::uint64_t reverse_lanes( std::uint64_t word ) noexcept
+{
+   if constexpr( S <= 4U ) {
+      word = ( word >> 32 ) | ( word << 32 );
+   }
+   if constexpr( S <= 2U ) {
+      word = ( ( word & 0xFFFF0000FFFF0000ULL ) >> 16 ) | ( ( word & 0x0000FFFF0000FFFFULL ) << 16 );
+   }
+   if constexpr( S == 1U ) {
+      word = ( ( word & 0xFF00FF00FF00FF00ULL ) >>  8 ) | ( ( word & 0x00FF00FF00FF00FFULL ) <<  8 );
+   }
+   return word;
+}
+
+// Word-at-a-time kernel: Compares 8 bytes from both ends per step. The function advances 'first'
+// and 'last' towards the middle of the range as long as the compared blocks are symmetric.
+template< typename T >
+bool compare_words( T const*& first, T const*& last ) noexcept
+{
+   constexpr std::size_t L( sizeof(std::uint64_t) / sizeof(T) );
+
+   std::uint64_t front, back;
+
+   for( ; static_cast<std::size_t>( last-first ) >= 2U*L; first+=L, last-=L ) {
+      std::memcpy( &front, first , sizeof(front) );
+      std::memcpy( &back , last-L, sizeof(back)  );
+      if( front != reverse_lanes<sizeof(T)>( back ) ) return false;
+   }
+   return true;
+}
+
+#if PALINDROME_X86_DISPATCH
+// AVX2 kernel: Compares 32 bytes from both ends per step, compiled independently of the target
+// architecture. The back block is reversed in the register by means of byte shuffles within the
+// two 128-bit lanes and a subsequent exchange of the lanes.
+template< typename T >
+__attribute__((target("avx2"))) bool compare_avx2( T const*& first, T const*& last ) noexcept
+{
+   constexpr std::size_t L( 32U / sizeof(T) );
+
+   __m256i reverse;
+   if constexpr( sizeof(T) == 1U ) {
+      reverse = _mm256_setr_epi8( 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+                                , 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 );
+   }
+   if constexpr( sizeof(T) == 2U ) {
+      reverse = _mm256_setr_epi8( 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+                                , 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1 );
+   }
+   if constexpr( sizeof(T) == 4U ) {
+      reverse = _mm256_setr_epi32( 7, 6, 5, 4, 3, 2, 1, 0 );
+   }
+
+   for( ; static_cast<std::size_t>( last-first ) >= 2U*L; first+=L, last-=L )
+   {
+      __m256i const front = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( first ) );
+      __m256i back = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( last-L ) );
+
+      if constexpr( sizeof(T) <= 2U ) {
+         back = _mm256_permute4x64_epi64( _mm256_shuffle_epi8( back, reverse ), 0x4E );
+      }
+      if constexpr( sizeof(T) == 4U ) {
+         back = _mm256_permutevar8x32_epi32( back, reverse );
+      }
+      if constexpr( sizeof(T) == 8U ) {
+         back = _mm256_permute4x64_epi64( back, 0x1B );
+      }
+
+      __m256i const diff = _mm256_xor_si256( front, back );
+      if( !_mm256_testz_si256( diff, diff ) ) return false;
+   }
+   return true;
+}
+
+inline bool has_avx2() noexcept
+{
+   static bool const avx2 = __builtin_cpu_supports( "avx2" );
+   return avx2;
+}
+#endif
+
+template< std::contiguous_iterator ContiguousIt >
+   requires BitwiseComparable< std::iter_value_t<ContiguousIt> >
+constexpr bool is_palindrome( ContiguousIt first, ContiguousIt last )
+{
+   auto const size = last - first;
+
+   if( size == 0 )
+      return false;
+
+   // Neither 'memcpy()' nor SIMD intrinsics are usable during compile time evaluation
+   if( std::is_constant_evaluated() ) {
+      return std::equal( first, first + size/2, std::make_reverse_iterator( last ) );
+   }
+
+   using T = std::iter_value_t<ContiguousIt>;
+
+   T const* front = std::to_address( first );
+   T const* back  = front + size;
+
+#if PALINDROME_X86_DISPATCH
+   if( has_avx2() && !compare_avx2( front, back ) ) return false;
+#endif
+   if( !compare_words( front, back ) ) return false;
+
+   return std::equal( front, front + (back-front)/2, std::make_reverse_iterator( back ) );
+}
+
+
+// Average time in microseconds for the given check
+template< typename Check >
+double benchmark( Check check, std::size_t repetitions )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( std::size_t rep=0U; rep<repetitions; ++rep ) {
+      if( !check() ) std::abort();
+   }
+   std::chrono::duration<double,std::micro> const time = Clock::now() - start;
+
+   return time.count() / repetitions;
+}
+
+// Comparison of the element-wise and the block-wise check of large symmetric buffers
+template< typename T >
+void benchmark_palindrome( char const* type )
+{
+   std::cout << " " << type << "\n"
+             << "     Bytes   Element-wise    Block-wise\n";
+
+   for( std::size_t bytes : { 4096UL, 65536UL, 1UL << 20, 16UL << 20 } )
+   {
+      std::size_t const n = bytes / sizeof(T);
+      std::size_t const repetitions = std::max<std::size_t>( ( 256UL << 20 ) / bytes, 4U );
+
+      std::vector<T> v( n );
+      for( std::size_t i=0U; i<n/2U; ++i ) {
+         v[i] = v[n-1U-i] = static_cast<T>( i % 100U );
+      }
+
+      // The reverse iterators are not contiguous and therefore select the element-wise algorithm
+      double const t1 = benchmark( [&]{ return is_palindrome( rbegin(v), rend(v) ); }, repetitions );
+      double const t2 = benchmark( [&]{ return is_palindrome( begin(v), end(v) ); }, repetitions );
+
+      std::cout << std::setw(10) << bytes
+                << std::setw(12) << t1 << " us"
+                << std::setw(11) << t2 << " us\n";
+   }
+   std::cout << "\n";
+}
+
+
 int main()
 {
    std::vector<int> v1{ 3, 2, 11, 5, 4, 4, 5, 11, 2, 3 };   // Palindrome with even number of elements
@@ -79,5 +257,27 @@ int main()
    assert(  is_palindrome( begin(s2), end(s2) ) );
    assert( !is_palindrome( begin(s3), end(s3) ) );
 
+   // Block-wise check of ranges of all lengths, with a single mismatch at every position
+   for( std::size_t n=1U; n<200U; ++n )
+   {
+      std::vector<short> v( n );
+      for( std::size_t i=0U; i<n; ++i ) {
+         v[i] = v[n-1U-i] = static_cast<short>( i );
+      }
+      assert( is_palindrome( begin(v), end(v) ) );
+
+      for( std::size_t i=0U; i<n; ++i ) {
+         if( 2U*i+1U == n ) continue;  // The middle element of odd ranges is irrelevant
+         ++v[i];
+         assert( !is_palindrome( begin(v), end(v) ) );
+         --v[i];
+      }
+   }
+
+   static_assert( is_palindrome( std::begin("racecar"), std::end("racecar")-1 ) );
+
+   benchmark_palindrome<char>( "char" );
+   benchmark_palindrome<int>( "int" );
+
    return EXIT_SUCCESS;
 }
@@ -36,15 +36,26 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <compare>
+#include <concepts>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 // C++20
 //#include <format>
@@ -79,6 +90,137 @@ template< typename T >
 inline constexpr bool is_optional_v = is_optional<T>::value;
 
 
+// Customization point for types with an invalid value (a "niche"), which can represent the empty
+// state of an 'Optional' instead of an additional flag. A specialization has to provide
+//  - 'static constexpr T empty()': Returns the invalid value representing the empty state;
+//  - 'static constexpr bool is_empty( const T& )': Checks for the invalid value.
+// Note that the invalid value can no longer be stored as a regular value.
+template< typename T >
+struct niche_traits;
+
+template< typename T >
+concept HasNiche =
+   std::is_trivially_destructible_v<T> &&
+   requires( const T& value ) {
+      { niche_traits<T>::empty() } -> std::same_as<T>;
+      { niche_traits<T>::is_empty( value ) } -> std::same_as<bool>;
+   };
+
+// Note that pointers have no niche by default, since an engaged null pointer is a valid value. A
+// pointer type, for which the null pointer is known to be invalid, can opt in via 'niche_value'
+// (see below).
+
+// IEEE 754 floating point types use a quiet NaN with a dedicated payload (0xADD) as niche. Since
+// the bit pattern is compared, all other NaN values (incl. 'quiet_NaN()') remain valid values.
+// This single bit pattern, however, cannot be stored: storing it results in an empty 'Optional'
+// (and an assertion failure in debug builds).
+template< typename T >
+   requires( std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 &&
+             ( sizeof(T) == 4U || sizeof(T) == 8U ) )
+struct niche_traits<T>
+{
+   using Bits = std::conditional_t< sizeof(T) == 4U, std::uint32_t, std::uint64_t >;
+
+   static constexpr Bits bits =
+      static_cast<Bits>( sizeof(T) == 4U ? 0x7FC00ADDULL : 0x7FF8000000000ADDULL );
+
+   static constexpr T empty() noexcept { return std::bit_cast<T>( bits ); }
+   static constexpr bool is_empty( T value ) noexcept { return std::bit_cast<Bits>( value ) == bits; }
+};
+
+// Convenience base for a user-declared invalid value, e.g.
+//    template<> struct niche_traits<Id> : niche_value< Id, Id{ ~0U } > {};
+//    template<> struct niche_traits<Node*> : niche_value< Node*, nullptr > {};
+template< typename T, T Invalid >
+struct niche_value
+{
+   static constexpr T empty() noexcept { return Invalid; }
+   static constexpr bool is_empty( const T& value ) noexcept { return value == Invalid; }
+};
+
+
+namespace detail {
+
+// Storage of the value of an 'Optional' with an additional flag for the empty state
+template< typename T >
+class OptionalStorage
+{
+ public:
+   constexpr OptionalStorage() = default;
+
+   constexpr ~OptionalStorage() = default;
+   constexpr ~OptionalStorage() requires( !std::is_trivially_destructible_v<T> )
+   {
+      if( used_ ) std::destroy_at( &v_.value_ );
+   }
+
+   constexpr bool engaged() const noexcept { return used_; }
+
+   constexpr T&       get()       noexcept { return v_.value_; }
+   constexpr const T& get() const noexcept { return v_.value_; }
+
+   template< typename... Args >
+   constexpr void construct( Args&&... args )
+   {
+      std::construct_at( &v_.value_, std::forward<Args>( args )... );
+      used_ = true;
+   }
+
+   constexpr void destroy() noexcept
+   {
+      std::destroy_at( &v_.value_ );
+      used_ = false;
+   }
+
+ private:
+   union Union {
+      Union() = default;
+      Union() requires( !std::is_trivially_default_constructible_v<T> ) {}
+      ~Union() = default;
+      ~Union() requires( !std::is_trivially_destructible_v<T> ) {}
+      T value_;
+   } v_;
+   bool used_{ false };
+};
+
+// Storage of the value of an 'Optional' without any space overhead, which represents the empty
+// state by means of the niche of the type
+template< HasNiche T >
+class OptionalStorage<T>
+{
+ public:
+   constexpr bool engaged() const noexcept { return !niche_traits<T>::is_empty( value_ ); }
+
+   constexpr T&       get()       noexcept { return value_; }
+   constexpr const T& get() const noexcept { return value_; }
+
+   template< typename... Args >
+   constexpr void construct( Args&&... args )
+   {
+      std::destroy_at( &value_ );
+      try {
+         std::construct_at( &value_, std::forward<Args>( args )... );
+      }
+      catch( ... ) {
+         std::construct_at( &value_, niche_traits<T>::empty() );
+         throw;
+      }
+      assert( engaged() );  // The niche cannot be stored as a regular value
+   }
+
+   constexpr void destroy() noexcept
+   {
+      std::destroy_at( &value_ );
+      std::construct_at( &value_, niche_traits<T>::empty() );
+   }
+
+ private:
+   T value_{ niche_traits<T>::empty() };
+};
+
+} // namespace detail
+
+
 template< typename T >
 class Optional
 {
@@ -111,20 +253,18 @@ class Optional
    constexpr Optional( const Optional& ) = default;
    constexpr Optional( const Optional& other )
       requires( !std::is_trivially_copy_constructible_v<T> )
-      : used_{ other.used_ }
    {
-      if( has_value() ) {
-         std::construct_at( &v_.value_, other.value() );
+      if( other.has_value() ) {
+         s_.construct( other.value() );
       }
    }
 
    constexpr Optional( Optional&& ) = default;
    constexpr Optional( Optional&& other )
       requires( !std::is_trivially_move_constructible_v<T> )
-      : used_{ other.used_ }
    {
-      if( has_value() ) {
-         std::construct_at( &v_.value_, std::move(other).value() );
+      if( other.has_value() ) {
+         s_.construct( std::move(other).value() );
       }
    }
 
@@ -132,10 +272,9 @@ class Optional
    constexpr Optional( const Optional<U>& other )
       requires( std::is_constructible_v< T, const U& > &&
                 !is_constructible_or_convertible_v<U> )
-      : used_( other.has_value() )
    {
-      if( has_value() ) {
-         std::construct_at( &v_.value_, other.value() );
+      if( other.has_value() ) {
+         s_.construct( other.value() );
       }
    }
 
@@ -143,28 +282,23 @@ class Optional
    constexpr Optional( Optional<U>&& other )
       requires( std::is_constructible_v< T, U&& > &&
                 !is_constructible_or_convertible_v<U> )
-      : used_( other.has_value() )
    {
-      if( has_value() ) {
-         std::construct_at( &v_.value_, std::move(other).value() );
+      if( other.has_value() ) {
+         s_.construct( std::move(other).value() );
       }
    }
 
    template< typename U = value_type >
    constexpr Optional( U&& value )
-      requires( !is_optional_v< std::decay_t<U> > )
-      : used_{ true }
+      requires( !is_optional_v< std::decay_t<U> > &&
+                std::is_constructible_v< T, U&& > )
    {
-      std::construct_at( &v_.value_, std::forward<U>( value ) );
+      s_.construct( std::forward<U>( value ) );
    }
 
+   // The destruction of the value is handled by the storage
    constexpr ~Optional() = default;
 
-   constexpr ~Optional() requires( !std::is_trivially_destructible_v<T> )
-   {
-      if( has_value() ) std::destroy_at( &v_.value_ );
-   }
-
    constexpr Optional& operator=( std::nullptr_t ) { reset(); }
 
    constexpr Optional& operator=( const Optional& ) = default;
@@ -241,59 +375,51 @@ class Optional
 
    template< typename U >
    constexpr Optional& operator=( U&& value )
-      requires( !is_optional_v< std::decay_t<U> > )
+      requires( !is_optional_v< std::decay_t<U> > &&
+                std::is_constructible_v< T, U&& > )
    {
       if( has_value() ) {
-         value() = std::forward<U>( value );
+         this->value() = std::forward<U>( value );
       }
       else {
-         std::construct_at( &v_.value_, std::forward<U>( value ) );
+         s_.construct( std::forward<U>( value ) );
       }
 
       return *this;
    }
 
-   constexpr explicit operator bool() const noexcept { return used_; }
-   constexpr bool has_value() const noexcept { return used_; }
+   constexpr explicit operator bool() const noexcept { return s_.engaged(); }
+   constexpr bool has_value() const noexcept { return s_.engaged(); }
 
-   constexpr T*       operator->()       &  { return &v_.value_; }
-   constexpr const T* operator->() const &  { return &v_.value_; }
+   constexpr T*       operator->()       &  { return &s_.get(); }
+   constexpr const T* operator->() const &  { return &s_.get(); }
 
    constexpr T&        operator*()       &  { return value(); }
    constexpr const T&  operator*() const &  { return value(); }
    constexpr T&&       operator*()       && { return value(); }
    constexpr const T&& operator*() const && { return value(); }
 
-   constexpr T&        value()       &  { return v_.value_; }
-   constexpr const T&  value() const &  { return v_.value_; }
-   constexpr T&&       value()       && { return std::move( v_.value_ ); }
-   constexpr const T&& value() const && { return std::move( v_.value_ ); }
+   constexpr T&        value()       &  { return s_.get(); }
+   constexpr const T&  value() const &  { return s_.get(); }
+   constexpr T&&       value()       && { return std::move( s_.get() ); }
+   constexpr const T&& value() const && { return std::move( s_.get() ); }
 
    constexpr void reset() noexcept
    {
       if( has_value() )
-         std::destroy_at( &v_.value_ );
-      used_ = false;
+         s_.destroy();
    }
 
    template< typename... Args >
    constexpr T& emplace( Args&&... args )
    {
       reset();
-      std::construct_at( &v_.value_, std::forward<Args>( args )... );
-      used_ = true;
+      s_.construct( std::forward<Args>( args )... );
       return value();
    }
 
  private:
-   union Union {
-      Union() = default;
-      Union() requires( !std::is_trivially_default_constructible_v<T> ) {}
-      ~Union() = default;
-      ~Union() requires( !std::is_trivially_destructible_v<T> ) {}
-      T value_;
-   } v_;
-   bool used_{ false };
+   detail::OptionalStorage<T> s_;
 };
 
 
@@ -460,6 +586,759 @@ struct std::formatter< Optional<T> >
 */
 
 
+//---- <OptionalVector.h> -------------------------------------------------------------------------
+
+// Columnar container for optional values (in the style of Apache Arrow): All values are stored in
+// a dense array and the engaged state of each element is stored in a packed validity bitmap. The
+// values of empty elements are default constructed placeholders. In contrast to a vector of
+// 'Optional', there is neither padding nor an interleaved flag per element, and bulk operations
+// can process 64 elements per validity word.
+template< typename T >
+   requires( std::is_default_constructible_v<T> )
+class OptionalVector
+{
+ private:
+   using Word = std::uint64_t;
+
+   static constexpr size_t bitsPerWord = 64U;
+
+ public:
+   using value_type = T;
+
+   class const_reference;
+
+   // Proxy for an element, providing the same interface as an 'Optional' lvalue
+   class reference
+   {
+    public:
+      constexpr reference( const reference& ) = default;
+      constexpr explicit operator bool() const noexcept { return has_value(); }
+      constexpr bool has_value() const noexcept { return vector_->test( index_ ); }
+
+      constexpr T& operator*()  const { return value(); }
+      constexpr T* operator->() const { return &value(); }
+      constexpr T& value()      const { return vector_->values_[index_]; }
+
+      constexpr void reset() noexcept { vector_->clear( index_ ); }
+
+      template< typename... Args >
+      constexpr T& emplace( Args&&... args )
+      {
+         value() = T( std::forward<Args>( args )... );
+         vector_->set( index_ );
+         return value();
+      }
+
+      // Assignments write the referenced element instead of rebinding the proxy (as for
+      // 'std::vector<bool>::reference')
+      constexpr reference& operator=( const reference& other )
+      {
+         if( other.has_value() ) emplace( other.value() );
+         else                    reset();
+         return *this;
+      }
+
+      constexpr reference& operator=( const const_reference& other )
+      {
+         if( other.has_value() ) emplace( other.value() );
+         else                    reset();
+         return *this;
+      }
+
+      constexpr reference& operator=( std::nullopt_t ) noexcept
+      {
+         reset();
+         return *this;
+      }
+
+      constexpr reference& operator=( const Optional<T>& o )
+      {
+         if( o.has_value() ) emplace( *o );
+         else                reset();
+         return *this;
+      }
+
+      template< typename U = T >
+      constexpr reference& operator=( U&& value )
+         requires( !is_optional_v< std::decay_t<U> > &&
+                   !std::is_same_v< std::decay_t<U>, std::nullopt_t > &&
+                   !std::is_same_v< std::decay_t<U>, reference > &&
+                   !std::is_same_v< std::decay_t<U>, const_reference > )
+      {
+         emplace( std::forward<U>( value ) );
+         return *this;
+      }
+
+      constexpr operator Optional<T>() const
+      {
+         return has_value() ? Optional<T>( value() ) : Optional<T>{};
+      }
+
+      friend constexpr bool operator==( const reference& r, std::nullopt_t ) noexcept
+      {
+         return !r.has_value();
+      }
+
+      friend constexpr bool operator==( const reference& r, const T& value )
+      {
+         return r.has_value() && r.value() == value;
+      }
+
+    private:
+      friend class OptionalVector;
+
+      constexpr reference( OptionalVector* vector, size_t index ) noexcept
+         : vector_( vector ), index_( index )
+      {}
+
+      OptionalVector* vector_;
+      size_t index_;
+   };
+
+   // Read-only proxy for an element, providing the same interface as an 'Optional' rvalue
+   class const_reference
+   {
+    public:
+      constexpr explicit operator bool() const noexcept { return has_value(); }
+      constexpr bool has_value() const noexcept { return vector_->test( index_ ); }
+
+      constexpr const T& operator*()  const { return value(); }
+      constexpr const T* operator->() const { return &value(); }
+      constexpr const T& value()      const { return vector_->values_[index_]; }
+
+      constexpr operator Optional<T>() const
+      {
+         return has_value() ? Optional<T>( value() ) : Optional<T>{};
+      }
+
+      friend constexpr bool operator==( const const_reference& r, std::nullopt_t ) noexcept
+      {
+         return !r.has_value();
+      }
+
+      friend constexpr bool operator==( const const_reference& r, const T& value )
+      {
+         return r.has_value() && r.value() == value;
+      }
+
+    private:
+      friend class OptionalVector;
+
+      constexpr const_reference( const OptionalVector* vector, size_t index ) noexcept
+         : vector_( vector ), index_( index )
+      {}
+
+      const OptionalVector* vector_;
+      size_t index_;
+   };
+
+   constexpr OptionalVector() = default;
+
+   // Creates 'n' empty elements
+   constexpr explicit OptionalVector( size_t n )
+      : values_( n )
+      , bits_( words( n ) )
+   {}
+
+   constexpr size_t size()  const noexcept { return values_.size(); }
+   constexpr bool   empty() const noexcept { return values_.empty(); }
+
+   constexpr reference       operator[]( size_t index )       noexcept { return reference( this, index ); }
+   constexpr const_reference operator[]( size_t index ) const noexcept { return const_reference( this, index ); }
+
+   constexpr void reserve( size_t n )
+   {
+      values_.reserve( n );
+      bits_.reserve( words( n ) );
+   }
+
+   constexpr void push_back( const Optional<T>& o )
+   {
+      if( size() % bitsPerWord == 0U ) {
+         bits_.push_back( Word{} );
+      }
+      values_.push_back( o.has_value() ? *o : T{} );
+      if( o.has_value() ) set( size()-1U );
+   }
+
+   constexpr void push_back( std::nullopt_t )
+   {
+      push_back( Optional<T>{} );
+   }
+
+   // Number of engaged elements
+   constexpr size_t count_engaged() const noexcept
+   {
+      size_t count{};
+      for( Word const word : bits_ ) {
+         count += static_cast<size_t>( std::popcount( word ) );
+      }
+      return count;
+   }
+
+   // Assigns the given value to all empty elements, which leaves all elements engaged
+   constexpr void fill_missing( const T& value )
+   {
+      for( size_t w=0U; w<bits_.size(); ++w )
+      {
+         Word const word = bits_[w];
+         size_t const first = w*bitsPerWord;
+         size_t const last  = std::min( first+bitsPerWord, size() );
+
+         if( ~word == Word{} ) continue;
+
+         for( size_t i=first; i<last; ++i ) {
+            if( !( ( word >> (i-first) ) & 1U ) ) values_[i] = value;
+         }
+         bits_[w] = ( last-first == bitsPerWord ) ? ~Word{} : ( Word{1} << (last-first) ) - 1U;
+      }
+   }
+
+   // Sum of all engaged values: Full words are summed without any check, empty words are skipped
+   // and all other words are summed by means of a branch-free mask. All loops accumulate into
+   // independent lanes, which enables the compiler to map them onto SIMD registers.
+   constexpr T sum() const noexcept
+      requires( std::is_arithmetic_v<T> )
+   {
+      constexpr size_t L( 8U );
+      T lanes[L]{};
+
+      for( size_t w=0U; w<bits_.size(); ++w )
+      {
+         Word const word = bits_[w];
+         T const* const values = values_.data() + w*bitsPerWord;
+         size_t const n = std::min( bitsPerWord, size()-w*bitsPerWord );
+
+         if( word == Word{} ) continue;
+
+         if( ~word == Word{} ) {
+            for( size_t i=0U; i<bitsPerWord; ++i ) {
+               lanes[i%L] += values[i];
+            }
+         }
+         else {
+            for( size_t i=0U; i<n; ++i ) {
+               lanes[i%L] += ( ( word >> i ) & 1U ) ? values[i] : T{};
+            }
+         }
+      }
+
+      T result{};
+      for( T const lane : lanes ) {
+         result += lane;
+      }
+      return result;
+   }
+
+   // Memory occupied by the values and the validity bitmap
+   constexpr size_t bytes() const noexcept
+   {
+      return values_.size()*sizeof(T) + bits_.size()*sizeof(Word);
+   }
+
+ private:
+   static constexpr size_t words( size_t n ) noexcept { return ( n + bitsPerWord - 1U ) / bitsPerWord; }
+
+   constexpr bool test( size_t index ) const noexcept
+   {
+      return ( bits_[index/bitsPerWord] >> (index%bitsPerWord) ) & 1U;
+   }
+
+   constexpr void set( size_t index ) noexcept
+   {
+      bits_[index/bitsPerWord] |= Word{1} << (index%bitsPerWord);
+   }
+
+   constexpr void clear( size_t index ) noexcept
+   {
+      bits_[index/bitsPerWord] &= ~( Word{1} << (index%bitsPerWord) );
+   }
+
+   std::vector<T>    values_;
+   std::vector<Word> bits_;
+};
+
+
+//---- <Expected.h> -------------------------------------------------------------------------------
+
+// Wrapper for an error value, which selects the error state of an 'Expected'
+template< typename E >
+class Unexpected
+{
+ public:
+   constexpr explicit Unexpected( const E& error ) : error_( error ) {}
+   constexpr explicit Unexpected( E&& error ) : error_( std::move( error ) ) {}
+
+   constexpr E&        error()       &  noexcept { return error_; }
+   constexpr const E&  error() const &  noexcept { return error_; }
+   constexpr E&&       error()       && noexcept { return std::move( error_ ); }
+   constexpr const E&& error() const && noexcept { return std::move( error_ ); }
+
+ private:
+   E error_;
+};
+
+template< typename E >
+Unexpected( E ) -> Unexpected<E>;
+
+
+struct unexpect_t { explicit unexpect_t() = default; };
+inline constexpr unexpect_t unexpect{};
+
+
+template< typename T, typename E >
+class Expected;
+
+
+namespace detail {
+
+template< typename T, typename E >
+std::true_type is_expected( const volatile Expected<T,E>* );
+
+std::false_type is_expected( ... );
+
+template< typename E >
+std::true_type is_unexpected( const volatile Unexpected<E>* );
+
+std::false_type is_unexpected( ... );
+
+} // namespace detail
+
+template< typename T >
+struct is_expected
+   : public decltype( detail::is_expected( std::declval<T*>() ) )
+{};
+
+template< typename T >
+struct is_expected<T&>
+   : public std::false_type
+{};
+
+template< typename T >
+inline constexpr bool is_expected_v = is_expected<T>::value;
+
+template< typename T >
+inline constexpr bool is_unexpected_v =
+   decltype( detail::is_unexpected( std::declval<T*>() ) )::value;
+
+
+namespace detail {
+
+// Tag for the construction of the value or error of an 'Expected' from the result of a function
+// call, which enables the construction in place without any intermediate copy or move
+struct invoke_value_t { explicit invoke_value_t() = default; };
+struct invoke_error_t { explicit invoke_error_t() = default; };
+
+// Storage of either a value or an error, based on the same conditionally trivial union as the
+// storage of an 'Optional'
+template< typename T, typename E >
+class ExpectedStorage
+{
+ public:
+   constexpr ExpectedStorage() = default;
+
+   constexpr ~ExpectedStorage() = default;
+   constexpr ~ExpectedStorage()
+      requires( !std::is_trivially_destructible_v<T> || !std::is_trivially_destructible_v<E> )
+   {
+      destroy();
+   }
+
+   constexpr bool has_value() const noexcept { return has_value_; }
+
+   constexpr T&       value()       noexcept { return u_.value_; }
+   constexpr const T& value() const noexcept { return u_.value_; }
+   constexpr E&       error()       noexcept { return u_.error_; }
+   constexpr const E& error() const noexcept { return u_.error_; }
+
+   template< typename... Args >
+   constexpr void construct_value( Args&&... args )
+   {
+      std::construct_at( &u_.value_, std::forward<Args>( args )... );
+      has_value_ = true;
+   }
+
+   template< typename... Args >
+   constexpr void construct_error( Args&&... args )
+   {
+      std::construct_at( &u_.error_, std::forward<Args>( args )... );
+      has_value_ = false;
+   }
+
+   template< typename F, typename... Args >
+   constexpr void invoke_value( F&& f, Args&&... args )
+   {
+      std::construct_at( &u_.value_, std::invoke( std::forward<F>( f ), std::forward<Args>( args )... ) );
+      has_value_ = true;
+   }
+
+   template< typename F, typename... Args >
+   constexpr void invoke_error( F&& f, Args&&... args )
+   {
+      std::construct_at( &u_.error_, std::invoke( std::forward<F>( f ), std::forward<Args>( args )... ) );
+      has_value_ = false;
+   }
+
+   constexpr void destroy() noexcept
+   {
+      if( has_value_ ) std::destroy_at( &u_.value_ );
+      else             std::destroy_at( &u_.error_ );
+   }
+
+ private:
+   union Union {
+      constexpr Union() {}
+      ~Union() = default;
+      ~Union() requires( !std::is_trivially_destructible_v<T> || !std::is_trivially_destructible_v<E> ) {}
+      T value_;
+      E error_;
+   } u_;
+   bool has_value_{ false };
+};
+
+} // namespace detail
+
+
+// Either a value of type 'T' or an error of type 'E'. In contrast to 'std::expected', no function
+// ever throws: Accessing the value of an error state (or vice versa) is a precondition violation.
+// Switching between both states requires 'T' and 'E' to be nothrow move constructible, which
+// guarantees that an 'Expected' always holds either a value or an error.
+template< typename T, typename E >
+class Expected
+{
+ private:
+   static_assert( !std::is_reference_v<T> && !std::is_void_v<T>, "Invalid value type" );
+   static_assert( !std::is_reference_v<E> && !std::is_void_v<E>, "Invalid error type" );
+   static_assert( !is_unexpected_v< std::remove_cv_t<T> >, "Invalid value type" );
+   static_assert( std::is_nothrow_move_constructible_v<T> &&
+                  std::is_nothrow_move_constructible_v<E>,
+                  "Value and error type must be nothrow move constructible" );
+
+   template< typename U >
+   static constexpr bool is_trivially_copyable_both_v =
+      std::is_trivially_copy_constructible_v<U> && std::is_trivially_copy_assignable_v<U> &&
+      std::is_trivially_destructible_v<U>;
+
+   template< typename U >
+   static constexpr bool is_trivially_movable_both_v =
+      std::is_trivially_move_constructible_v<U> && std::is_trivially_move_assignable_v<U> &&
+      std::is_trivially_destructible_v<U>;
+
+ public:
+   using value_type = T;
+   using error_type = E;
+
+   template< typename U >
+   using rebind = Expected<U,E>;
+
+   constexpr Expected()
+      requires( std::is_default_constructible_v<T> )
+   {
+      s_.construct_value();
+   }
+
+   constexpr Expected( const Expected& ) = default;
+   constexpr Expected( const Expected& other )
+      requires( !std::is_trivially_copy_constructible_v<T> || !std::is_trivially_copy_constructible_v<E> )
+   {
+      if( other.has_value() ) s_.construct_value( other.s_.value() );
+      else                    s_.construct_error( other.s_.error() );
+   }
+
+   constexpr Expected( Expected&& ) = default;
+   constexpr Expected( Expected&& other ) noexcept
+      requires( !std::is_trivially_move_constructible_v<T> || !std::is_trivially_move_constructible_v<E> )
+   {
+      if( other.has_value() ) s_.construct_value( std::move( other.s_.value() ) );
+      else                    s_.construct_error( std::move( other.s_.error() ) );
+   }
+
+   template< typename U = T >
+   constexpr Expected( U&& value )
+      requires( !is_expected_v< std::remove_cvref_t<U> > &&
+                !is_unexpected_v< std::remove_cvref_t<U> > &&
+                !std::is_same_v< std::remove_cvref_t<U>, std::in_place_t > &&
+                !std::is_same_v< std::remove_cvref_t<U>, unexpect_t > &&
+                std::is_constructible_v< T, U&& > )
+   {
+      s_.construct_value( std::forward<U>( value ) );
+   }
+
+   template< typename G >
+   constexpr Expected( const Unexpected<G>& u )
+      requires( std::is_constructible_v< E, const G& > )
+   {
+      s_.construct_error( u.error() );
+   }
+
+   template< typename G >
+   constexpr Expected( Unexpected<G>&& u )
+      requires( std::is_constructible_v< E, G&& > )
+   {
+      s_.construct_error( std::move( u ).error() );
+   }
+
+   template< typename... Args >
+   constexpr explicit Expected( std::in_place_t, Args&&... args )
+      requires( std::is_constructible_v< T, Args&&... > )
+   {
+      s_.construct_value( std::forward<Args>( args )... );
+   }
+
+   template< typename... Args >
+   constexpr explicit Expected( unexpect_t, Args&&... args )
+      requires( std::is_constructible_v< E, Args&&... > )
+   {
+      s_.construct_error( std::forward<Args>( args )... );
+   }
+
+   // The destruction of the value or error is handled by the storage
+   constexpr ~Expected() = default;
+
+   constexpr Expected& operator=( const Expected& ) = default;
+   constexpr Expected& operator=( const Expected& other )
+      requires( !is_trivially_copyable_both_v<T> || !is_trivially_copyable_both_v<E> )
+   {
+      if( has_value() && other.has_value() ) s_.value() = other.s_.value();
+      else if( other.has_value() )           reinit_value( other.s_.value() );
+      else if( has_value() )                 reinit_error( other.s_.error() );
+      else                                   s_.error() = other.s_.error();
+      return *this;
+   }
+
+   constexpr Expected& operator=( Expected&& ) = default;
+   constexpr Expected& operator=( Expected&& other )
+      noexcept( std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E> )
+      requires( !is_trivially_movable_both_v<T> || !is_trivially_movable_both_v<E> )
+   {
+      if( has_value() && other.has_value() ) s_.value() = std::move( other.s_.value() );
+      else if( other.has_value() )           reinit_value( std::move( other.s_.value() ) );
+      else if( has_value() )                 reinit_error( std::move( other.s_.error() ) );
+      else                                   s_.error() = std::move( other.s_.error() );
+      return *this;
+   }
+
+   template< typename U = T >
+   constexpr Expected& operator=( U&& value )
+      requires( !is_expected_v< std::remove_cvref_t<U> > &&
+                !is_unexpected_v< std::remove_cvref_t<U> > &&
+                std::is_constructible_v< T, U&& > && std::is_assignable_v< T&, U&& > )
+   {
+      if( has_value() ) s_.value() = std::forward<U>( value );
+      else              reinit_value( std::forward<U>( value ) );
+      return *this;
+   }
+
+   template< typename G >
+   constexpr Expected& operator=( const Unexpected<G>& u )
+   {
+      if( has_value() ) reinit_error( u.error() );
+      else              s_.error() = u.error();
+      return *this;
+   }
+
+   template< typename G >
+   constexpr Expected& operator=( Unexpected<G>&& u )
+   {
+      if( has_value() ) reinit_error( std::move( u ).error() );
+      else              s_.error() = std::move( u ).error();
+      return *this;
+   }
+
+   constexpr explicit operator bool() const noexcept { return s_.has_value(); }
+   constexpr bool has_value() const noexcept { return s_.has_value(); }
+
+   constexpr T*       operator->()       noexcept { return &value(); }
+   constexpr const T* operator->() const noexcept { return &value(); }
+
+   constexpr T&        operator*()       &  noexcept { return value(); }
+   constexpr const T&  operator*() const &  noexcept { return value(); }
+   constexpr T&&       operator*()       && noexcept { return std::move( value() ); }
+   constexpr const T&& operator*() const && noexcept { return std::move( value() ); }
+
+   constexpr T&        value()       &  noexcept { assert( has_value() ); return s_.value(); }
+   constexpr const T&  value() const &  noexcept { assert( has_value() ); return s_.value(); }
+   constexpr T&&       value()       && noexcept { assert( has_value() ); return std::move( s_.value() ); }
+   constexpr const T&& value() const && noexcept { assert( has_value() ); return std::move( s_.value() ); }
+
+   constexpr E&        error()       &  noexcept { assert( !has_value() ); return s_.error(); }
+   constexpr const E&  error() const &  noexcept { assert( !has_value() ); return s_.error(); }
+   constexpr E&&       error()       && noexcept { assert( !has_value() ); return std::move( s_.error() ); }
+   constexpr const E&& error() const && noexcept { assert( !has_value() ); return std::move( s_.error() ); }
+
+   template< typename U >
+   constexpr T value_or( U&& fallback ) const &
+   {
+      return has_value() ? s_.value() : static_cast<T>( std::forward<U>( fallback ) );
+   }
+
+   template< typename U >
+   constexpr T value_or( U&& fallback ) &&
+   {
+      return has_value() ? std::move( s_.value() ) : static_cast<T>( std::forward<U>( fallback ) );
+   }
+
+   template< typename... Args >
+   constexpr T& emplace( Args&&... args ) noexcept
+      requires( std::is_nothrow_constructible_v< T, Args&&... > )
+   {
+      s_.destroy();
+      s_.construct_value( std::forward<Args>( args )... );
+      return s_.value();
+   }
+
+   // Monadic operations: The value or error is forwarded with the value category of '*this',
+   // i.e. calling the operations on an rvalue moves the payload instead of copying it.
+
+   // Calls 'f' with the value, which has to return an 'Expected' with the same error type
+   template< typename F > constexpr auto and_then( F&& f ) &       { return and_then_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto and_then( F&& f ) const&  { return and_then_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto and_then( F&& f ) &&      { return and_then_impl( std::move( *this ), std::forward<F>( f ) ); }
+   template< typename F > constexpr auto and_then( F&& f ) const&& { return and_then_impl( std::move( *this ), std::forward<F>( f ) ); }
+
+   // Calls 'f' with the error, which has to return an 'Expected' with the same value type
+   template< typename F > constexpr auto or_else( F&& f ) &       { return or_else_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto or_else( F&& f ) const&  { return or_else_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto or_else( F&& f ) &&      { return or_else_impl( std::move( *this ), std::forward<F>( f ) ); }
+   template< typename F > constexpr auto or_else( F&& f ) const&& { return or_else_impl( std::move( *this ), std::forward<F>( f ) ); }
+
+   // Replaces the value by the result of 'f', which is constructed in place
+   template< typename F > constexpr auto transform( F&& f ) &       { return transform_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform( F&& f ) const&  { return transform_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform( F&& f ) &&      { return transform_impl( std::move( *this ), std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform( F&& f ) const&& { return transform_impl( std::move( *this ), std::forward<F>( f ) ); }
+
+   // Replaces the error by the result of 'f', which is constructed in place
+   template< typename F > constexpr auto transform_error( F&& f ) &       { return transform_error_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform_error( F&& f ) const&  { return transform_error_impl( *this, std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform_error( F&& f ) &&      { return transform_error_impl( std::move( *this ), std::forward<F>( f ) ); }
+   template< typename F > constexpr auto transform_error( F&& f ) const&& { return transform_error_impl( std::move( *this ), std::forward<F>( f ) ); }
+
+ private:
+   template< typename, typename > friend class Expected;
+
+   template< typename F, typename Arg >
+   constexpr Expected( detail::invoke_value_t, F&& f, Arg&& arg )
+   {
+      s_.invoke_value( std::forward<F>( f ), std::forward<Arg>( arg ) );
+   }
+
+   template< typename F, typename Arg >
+   constexpr Expected( detail::invoke_error_t, F&& f, Arg&& arg )
+   {
+      s_.invoke_error( std::forward<F>( f ), std::forward<Arg>( arg ) );
+   }
+
+   // Switches from the error to the value state; a temporary is only required in case the
+   // construction of the value might throw
+   template< typename... Args >
+   constexpr void reinit_value( Args&&... args )
+   {
+      if constexpr( std::is_nothrow_constructible_v< T, Args&&... > ) {
+         s_.destroy();
+         s_.construct_value( std::forward<Args>( args )... );
+      }
+      else {
+         T tmp( std::forward<Args>( args )... );
+         s_.destroy();
+         s_.construct_value( std::move( tmp ) );
+      }
+   }
+
+   // Switches from the value to the error state
+   template< typename... Args >
+   constexpr void reinit_error( Args&&... args )
+   {
+      if constexpr( std::is_nothrow_constructible_v< E, Args&&... > ) {
+         s_.destroy();
+         s_.construct_error( std::forward<Args>( args )... );
+      }
+      else {
+         E tmp( std::forward<Args>( args )... );
+         s_.destroy();
+         s_.construct_error( std::move( tmp ) );
+      }
+   }
+
+   template< typename Self, typename F >
+   static constexpr auto and_then_impl( Self&& self, F&& f )
+   {
+      using Result = std::remove_cvref_t< std::invoke_result_t< F, decltype( std::forward<Self>( self ).value() ) > >;
+      static_assert( is_expected_v<Result>, "and_then() requires a function returning an Expected" );
+      static_assert( std::is_same_v< typename Result::error_type, E >, "and_then() must not change the error type" );
+
+      if( self.has_value() )
+         return std::invoke( std::forward<F>( f ), std::forward<Self>( self ).value() );
+      else
+         return Result( unexpect, std::forward<Self>( self ).error() );
+   }
+
+   template< typename Self, typename F >
+   static constexpr auto or_else_impl( Self&& self, F&& f )
+   {
+      using Result = std::remove_cvref_t< std::invoke_result_t< F, decltype( std::forward<Self>( self ).error() ) > >;
+      static_assert( is_expected_v<Result>, "or_else() requires a function returning an Expected" );
+      static_assert( std::is_same_v< typename Result::value_type, T >, "or_else() must not change the value type" );
+
+      if( self.has_value() )
+         return Result( std::in_place, std::forward<Self>( self ).value() );
+      else
+         return std::invoke( std::forward<F>( f ), std::forward<Self>( self ).error() );
+   }
+
+   template< typename Self, typename F >
+   static constexpr auto transform_impl( Self&& self, F&& f )
+   {
+      using U = std::remove_cv_t< std::invoke_result_t< F, decltype( std::forward<Self>( self ).value() ) > >;
+      using Result = Expected<U,E>;
+
+      if( self.has_value() )
+         return Result( detail::invoke_value_t{}, std::forward<F>( f ), std::forward<Self>( self ).value() );
+      else
+         return Result( unexpect, std::forward<Self>( self ).error() );
+   }
+
+   template< typename Self, typename F >
+   static constexpr auto transform_error_impl( Self&& self, F&& f )
+   {
+      using G = std::remove_cv_t< std::invoke_result_t< F, decltype( std::forward<Self>( self ).error() ) > >;
+      using Result = Expected<T,G>;
+
+      if( self.has_value() )
+         return Result( std::in_place, std::forward<Self>( self ).value() );
+      else
+         return Result( detail::invoke_error_t{}, std::forward<F>( f ), std::forward<Self>( self ).error() );
+   }
+
+   detail::ExpectedStorage<T,E> s_;
+};
+
+
+template< typename T, typename E, typename U, typename G >
+constexpr bool operator==( const Expected<T,E>& lhs, const Expected<U,G>& rhs )
+{
+   if( lhs.has_value() != rhs.has_value() )
+      return false;
+   else if( lhs.has_value() )
+      return *lhs == *rhs;
+   else
+      return lhs.error() == rhs.error();
+}
+
+template< typename T, typename E, typename U >
+constexpr bool operator==( const Expected<T,E>& lhs, const U& rhs )
+   requires( !is_expected_v<U> && !is_unexpected_v<U> )
+{
+   return lhs.has_value() && *lhs == rhs;
+}
+
+template< typename T, typename E, typename G >
+constexpr bool operator==( const Expected<T,E>& lhs, const Unexpected<G>& rhs )
+{
+   return !lhs.has_value() && lhs.error() == rhs.error();
+}
+
+
 //---- <S.h> --------------------------------------------------------------------------------------
 
 struct S
@@ -486,8 +1365,118 @@ std::ostream& operator<<( std::ostream& os, const S& s )
 }
 
 
+//---- <UserId.h> ---------------------------------------------------------------------------------
+
+// Identifier type with a user-declared invalid value
+enum class UserId : std::uint32_t {};
+
+template<>
+struct niche_traits<UserId>
+   : public niche_value< UserId, UserId{ 0xFFFFFFFFU } >
+{};
+
+// Handle type, which is never null and therefore opts into the null pointer as niche
+struct Session;
+using SessionHandle = const Session*;
+
+template<>
+struct niche_traits<SessionHandle>
+   : public niche_value< SessionHandle, nullptr >
+{};
+
+
+//---- <ParseInt.h> -------------------------------------------------------------------------------
+
+enum class ParseError { empty, invalid_digit, overflow };
+
+// Conversion of a string of decimal digits into an 'int' without any exception
+constexpr Expected<int,ParseError> parse_int( std::string_view s ) noexcept
+{
+   if( s.empty() ) return Unexpected( ParseError::empty );
+
+   int result{};
+   for( char const c : s ) {
+      if( c < '0' || c > '9' ) return Unexpected( ParseError::invalid_digit );
+      int const digit( c - '0' );
+      if( result > ( std::numeric_limits<int>::max() - digit ) / 10 ) return Unexpected( ParseError::overflow );
+      result = result*10 + digit;
+   }
+   return result;
+}
+
+class ParseException
+   : public std::runtime_error
+{
+ public:
+   explicit ParseException( ParseError error )
+      : std::runtime_error( "Invalid integer" )
+      , error_( error )
+   {}
+
+   ParseError error() const noexcept { return error_; }
+
+ private:
+   ParseError error_;
+};
+
+// Conversion of a string of decimal digits into an 'int', which reports errors via exceptions
+int parse_int_or_throw( std::string_view s )
+{
+   auto result = parse_int( s );
+   if( !result ) throw ParseException( result.error() );
+   return *result;
+}
+
+
 //---- <Main.cpp> ---------------------------------------------------------------------------------
 
+// Time in milliseconds to sum up all engaged values of the given optionals
+template< typename Optionals >
+double scan( Optionals const& optionals, size_t repetitions, double& sum )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( size_t rep=0U; rep<repetitions; ++rep ) {
+      for( auto const& o : optionals ) {
+         if( o.has_value() ) sum += *o;
+      }
+   }
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count() / repetitions;
+}
+
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
+// Time in nanoseconds per conversion of the given strings
+template< typename Convert >
+double convert_all( std::vector<std::string> const& strings, Convert convert, long& sum, size_t& errors )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( std::string const& s : strings ) {
+      convert( s, sum, errors );
+   }
+   std::chrono::duration<double,std::nano> const time = Clock::now() - start;
+
+   return time.count() / strings.size();
+}
+
 
 int main()
 {
@@ -635,5 +1624,264 @@ int main()
       std::cout << "\n o2 = " << ( o2.has_value() ? *o2 : "<empty>" ) << "\n\n";
    }
 
+   // Types with a niche (floating point, user-declared invalid values)
+   {
+      static_assert( sizeof( Optional<double> ) == sizeof(double) );
+      static_assert( sizeof( Optional<float>  ) == sizeof(float)  );
+      static_assert( sizeof( Optional<UserId> ) == sizeof(UserId) );
+      static_assert( sizeof( Optional<SessionHandle> ) == sizeof(SessionHandle) );
+      static_assert( sizeof( Optional<int>    ) >  sizeof(int)    );
+      static_assert( sizeof( Optional<int*>   ) >  sizeof(int*)   );
+
+      static_assert( std::is_trivially_copy_constructible_v< Optional<SessionHandle> > );
+      static_assert( std::is_trivially_move_constructible_v< Optional<SessionHandle> > );
+      static_assert( std::is_trivially_destructible_v< Optional<SessionHandle> > );
+      static_assert( std::is_trivially_copy_assignable_v< Optional<SessionHandle> > );
+      static_assert( std::is_trivially_move_assignable_v< Optional<SessionHandle> > );
+
+      static_assert( !Optional<double>{}.has_value() );
+      static_assert( Optional<double>{ 1.0 }.has_value() );
+
+      // Regular NaN values are still valid values
+      Optional<double> o1{ std::numeric_limits<double>::quiet_NaN() };
+      assert( o1.has_value() );
+      o1.reset();
+      assert( o1 == std::nullopt );
+
+      int i{ 4 };
+      Optional<int*> o2{ &i };
+      assert( o2.has_value() && **o2 == 4 );
+      o2 = Optional<int*>{};
+      assert( !o2.has_value() );
+
+      // Raw pointers don't use a niche, i.e. an engaged null pointer remains a valid value
+      Optional<int*> o4{ nullptr };
+      assert( o4.has_value() && *o4 == nullptr );
+
+      Optional<SessionHandle> o5{};
+      assert( !o5.has_value() );
+
+      Optional<UserId> o3{};
+      assert( !o3.has_value() );
+      o3.emplace( UserId{ 42U } );
+      assert( o3 == UserId{ 42U } );
+
+      std::cout << " sizeof(Optional<double>) = " << sizeof( Optional<double> )
+                << ", sizeof(std::optional<double>) = " << sizeof( std::optional<double> ) << "\n\n";
+   }
+
+   // Comparison of scans over 10M optionals with and without niche
+   {
+      constexpr size_t N( 10000000U );
+      constexpr size_t repetitions( 10U );
+
+      std::vector< std::optional<double> > v1( N );
+      std::vector< Optional<double> > v2( N );
+      for( size_t i=0U; i<N; ++i ) {
+         if( i % 3U != 0U ) {
+            v1[i] = static_cast<double>( i % 100U );
+            v2[i] = static_cast<double>( i % 100U );
+         }
+      }
+
+      double sum{};
+      double const t1 = scan( v1, repetitions, sum );
+      double const t2 = scan( v2, repetitions, sum );
+
+      std::cout << " std::optional<double>: " << t1 << " ms (" << N*sizeof(v1[0])/(1U<<20) << " MiB)\n"
+                << " Optional<double>     : " << t2 << " ms (" << N*sizeof(v2[0])/(1U<<20) << " MiB)\n"
+                << " (checksum " << sum << ")\n\n";
+   }
+
+   // Columnar optionals with a validity bitmap
+   {
+      OptionalVector<int> v{};
+      v.push_back( Optional<int>{ 1 } );
+      v.push_back( std::nullopt );
+      v.push_back( Optional<int>{ 3 } );
+
+      assert( v.size() == 3U );
+      assert( v[0] == 1 && v[1] == std::nullopt && v[2] == 3 );
+      assert( v.count_engaged() == 2U );
+      assert( v.sum() == 4 );
+
+      v[1] = 2;
+      v[2].reset();
+      assert( v[1].has_value() && *v[1] == 2 && !v[2] );
+
+      Optional<int> const o = v[1];
+      assert( o == 2 );
+      v[0] = Optional<int>{};
+      assert( v.count_engaged() == 1U );
+
+      v.fill_missing( 7 );
+      assert( v.count_engaged() == 3U && v.sum() == 16 );
+
+      // Element-wise assignments between proxies: engaged to empty, empty to engaged, engaged to
+      // engaged and from a read-only proxy
+      {
+         OptionalVector<int> w{};
+         w.push_back( Optional<int>{ 1 } );
+         w.push_back( std::nullopt );
+         w.push_back( Optional<int>{ 3 } );
+         w.push_back( std::nullopt );
+
+         w[1] = w[0];
+         assert( w[0] == 1 && w[1] == 1 );
+
+         w[0] = w[3];
+         assert( w[0] == std::nullopt && w[3] == std::nullopt );
+
+         w[1] = w[2];
+         assert( w[1] == 3 && w[2] == 3 );
+
+         OptionalVector<int> const& cw = w;
+         w[3] = cw[1];
+         assert( w[3] == 3 && w.count_engaged() == 3U );
+      }
+
+      OptionalVector<int> const& cv = v;
+      std::cout << " OptionalVector: ( " << *cv[0] << " " << *cv[1] << " " << *cv[2] << " )\n\n";
+   }
+
+   // Comparison of a vector of optionals and a columnar OptionalVector
+   {
+      constexpr size_t N( 10000000U );
+      constexpr size_t repetitions( 10U );
+
+      std::vector< Optional<std::int64_t> > v1( N );
+      OptionalVector<std::int64_t> v2( N );
+      for( size_t i=0U; i<N; ++i ) {
+         // Runs of missing values mixed with scattered missing values
+         if( ( i / 4096U ) % 4U != 3U && i % 7U != 0U ) {
+            v1[i] = static_cast<std::int64_t>( i % 100U );
+            v2[i] = static_cast<std::int64_t>( i % 100U );
+         }
+      }
+
+      size_t count1{}, count2{};
+      std::int64_t sum1{}, sum2{};
+
+      double const c1 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            count1 += static_cast<size_t>( std::count_if( v1.begin(), v1.end(), []( auto const& o ){ return o.has_value(); } ) );
+      } ) / repetitions;
+      double const c2 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            count2 += v2.count_engaged();
+      } ) / repetitions;
+
+      double const s1 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            for( auto const& o : v1 )
+               if( o.has_value() ) sum1 += *o;
+      } ) / repetitions;
+      double const s2 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            sum2 += v2.sum();
+      } ) / repetitions;
+
+      double const f1 = measure( [&]{
+         for( auto& o : v1 )
+            if( !o.has_value() ) o = std::int64_t{ 1 };
+      } );
+      double const f2 = measure( [&]{
+         v2.fill_missing( std::int64_t{ 1 } );
+      } );
+
+      assert( count1 == count2 && sum1 == sum2 );
+      assert( std::ranges::all_of( v1, []( auto const& o ){ return o.has_value(); } ) );
+      assert( v2.count_engaged() == N );
+
+      std::cout << "                                        MiB   count_engaged          sum   fill_missing\n"
+                << " std::vector<Optional<int64_t>>" << std::setw(10) << N*sizeof(v1[0])/(1U<<20)
+                << std::setw(13) << c1 << " ms" << std::setw(10) << s1 << " ms" << std::setw(12) << f1 << " ms\n"
+                << " OptionalVector<int64_t>       " << std::setw(10) << v2.bytes()/(1U<<20)
+                << std::setw(13) << c2 << " ms" << std::setw(10) << s2 << " ms" << std::setw(12) << f2 << " ms\n"
+                << " (checksum " << count1+count2 << " " << sum1+sum2 << ")\n\n";
+   }
+
+   // Exception-free error handling with monadic operations
+   {
+      static_assert( parse_int( "42" ) == 42 );
+      static_assert( parse_int( "4x2" ) == Unexpected( ParseError::invalid_digit ) );
+      static_assert( parse_int( "99999999999" ) == Unexpected( ParseError::overflow ) );
+
+      static_assert( std::is_trivially_copy_constructible_v< Expected<int,ParseError> > );
+      static_assert( std::is_trivially_destructible_v< Expected<int,ParseError> > );
+      static_assert( !std::is_trivially_copy_constructible_v< Expected<std::string,ParseError> > );
+
+      auto const percent = []( int i ) -> Expected<int,ParseError> {
+         if( i > 100 ) return Unexpected( ParseError::overflow );
+         return i;
+      };
+
+      Expected<std::string,ParseError> const e1 =
+         parse_int( "42" ).and_then( percent ).transform( []( int i ){ return std::to_string( i ) + "%"; } );
+      assert( e1 == std::string( "42%" ) );
+
+      Expected<int,ParseError> const e2 =
+         parse_int( "420" ).and_then( percent ).or_else( []( ParseError ) -> Expected<int,ParseError> { return 100; } );
+      assert( e2 == 100 );
+
+      Expected<int,std::string> const e3 =
+         parse_int( "" ).transform_error( []( ParseError ){ return std::string( "empty" ); } );
+      assert( !e3.has_value() && e3.error() == "empty" );
+
+      // Move-only payloads are moved through the chain without any copy
+      Expected<std::unique_ptr<int>,ParseError> e4{ std::make_unique<int>( 2 ) };
+      Expected<std::unique_ptr<int>,ParseError> const e5 =
+         std::move( e4 ).transform( []( std::unique_ptr<int>&& p ){ *p *= 21; return std::move( p ); } );
+      assert( e5.has_value() && **e5 == 42 );
+
+      Expected<std::string,ParseError> e6{ "value" };
+      e6 = Unexpected( ParseError::empty );
+      assert( e6 == Unexpected( ParseError::empty ) );
+      e6 = "again";
+      assert( e6 == std::string( "again" ) );
+
+      std::cout << " parse_int(\"42\") -> " << *e1 << ", parse_int(\"420\") -> " << *e2 << "\n\n";
+   }
+
+   // Comparison of error reporting via exceptions and via 'Expected' for several error rates
+   {
+      constexpr size_t N( 200000U );
+
+      std::cout << " Error rate    exceptions      Expected\n";
+      for( size_t const rate : { 0U, 1U, 10U, 100U, 500U } )  // Errors per 1000 strings
+      {
+         std::vector<std::string> strings( N );
+         for( size_t i=0U; i<N; ++i ) {
+            strings[i] = std::to_string( i );
+            if( ( i * 7919U ) % 1000U < rate ) strings[i] += 'x';
+         }
+
+         long sum{};
+         size_t errors1{}, errors2{};
+
+         double const t1 = convert_all( strings, []( std::string const& s, long& sum, size_t& errors ) {
+            try {
+               sum += parse_int_or_throw( s );
+            }
+            catch( ParseException const& ) {
+               ++errors;
+            }
+         }, sum, errors1 );
+
+         double const t2 = convert_all( strings, []( std::string const& s, long& sum, size_t& errors ) {
+            auto const result = parse_int( s );
+            if( result ) sum += *result;
+            else         ++errors;
+         }, sum, errors2 );
+
+         assert( errors1 == errors2 );
+
+         std::cout << std::setw(10) << rate/10.0 << "%"
+                   << std::setw(11) << t1 << " ns"
+                   << std::setw(11) << t2 << " ns\n";
+      }
+      std::cout << "\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -14,12 +14,20 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 
 //---- <Widget.h> ---------------------------------------------------------------------------------
@@ -70,16 +78,36 @@ std::ostream& operator<<( std::ostream& os, Widget const& w )
 
 //---- <memory> -----------------------------------------------------------------------------------
 
+//==== Utility concepts ====
+template< typename U, typename T >
+concept pointer_convertible =
+   std::convertible_to<U*,T*>;
+
+
+
+
 //==== Simplified implementation of the 'default_delete' policy ====
 template< typename T >
 struct default_delete
 {
+   constexpr default_delete() noexcept = default;
+
+   template< typename U >
+      requires pointer_convertible<U,T>
+   default_delete( default_delete<U> const& ) noexcept {}
+
    void operator()( T* ptr ) const { delete ptr; }
 };
 
 template< typename T >
 struct default_delete<T[]>
 {
+   constexpr default_delete() noexcept = default;
+
+   template< typename U >
+      requires pointer_convertible<U[],T[]>
+   default_delete( default_delete<U[]> const& ) noexcept {}
+
    template< typename U >  // No constraint for 'U'
    void operator()( U* ptr ) const { delete[] ptr; }
 };
@@ -87,14 +115,6 @@ struct default_delete<T[]>
 
 
 
-//==== Utility concepts ====
-template< typename U, typename T >
-concept pointer_convertible =
-   std::convertible_to<U*,T*>;
-
-
-
-
 // Simplified implementation of the std::unique_ptr class template
 template< typename T, typename D = default_delete<T> >
 class unique_ptr
@@ -105,6 +125,8 @@ class unique_ptr
 
    constexpr unique_ptr();
    explicit  unique_ptr( T* ptr );
+             unique_ptr( T* ptr, D const& d );
+             unique_ptr( T* ptr, D&& d );
              unique_ptr( unique_ptr const& u ) = delete;
              unique_ptr( unique_ptr&& u ) noexcept;
 
@@ -129,8 +151,12 @@ class unique_ptr
 
    void swap( unique_ptr& other ) noexcept;
 
+   D&       get_deleter()       noexcept { return deleter_; }
+   D const& get_deleter() const noexcept { return deleter_; }
+
  private:
    T* ptr_;
+   [[no_unique_address]] D deleter_;  // Stateless deleters don't occupy any memory
 
    template< typename U, typename E > friend class unique_ptr;
 };
@@ -139,18 +165,35 @@ class unique_ptr
 template< typename T, typename D >
 constexpr unique_ptr<T,D>::unique_ptr()
    : ptr_( nullptr )
+   , deleter_()
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T,D>::unique_ptr( T* ptr )
    : ptr_( ptr )
+   , deleter_()
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( T* ptr, D const& d )
+   : ptr_( ptr )
+   , deleter_( d )
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( T* ptr, D&& d )
+   : ptr_( ptr )
+   , deleter_( std::move( d ) )
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T,D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -161,6 +204,7 @@ template< typename U, typename E >
    requires pointer_convertible<U,T>  // No constraint for 'E'
 unique_ptr<T,D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -169,16 +213,17 @@ unique_ptr<T,D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
 template< typename T, typename D >
 unique_ptr<T,D>::~unique_ptr() noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
 }
 
 
 template< typename T, typename D >
 unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -188,9 +233,10 @@ template< typename U, typename E >
    requires pointer_convertible<U,T>  // No constraint for 'E'
 unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr<U,E>&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -198,7 +244,7 @@ unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr<U,E>&& u ) noexcept
 template< typename T, typename D >
 void unique_ptr<T,D>::reset( pointer ptr ) noexcept
 {
-   unique_ptr tmp( std::exchange( ptr_, ptr ) );
+   deleter_( std::exchange( ptr_, ptr ) );
 }
 
 
@@ -213,6 +259,7 @@ template< typename T, typename D >
 void unique_ptr<T,D>::swap( unique_ptr& other ) noexcept
 {
    std::swap( ptr_, other.ptr_ );
+   std::swap( deleter_, other.deleter_ );
 }
 
 
@@ -228,6 +275,8 @@ class unique_ptr<T[],D>
 
    constexpr unique_ptr();
    explicit  unique_ptr( T* ptr );
+             unique_ptr( T* ptr, D const& d );
+             unique_ptr( T* ptr, D&& d );
              unique_ptr( unique_ptr const& u ) = delete;
              unique_ptr( unique_ptr&& u ) noexcept;
 
@@ -251,8 +300,12 @@ class unique_ptr<T[],D>
 
    void swap( unique_ptr& other ) noexcept;
 
+   D&       get_deleter()       noexcept { return deleter_; }
+   D const& get_deleter() const noexcept { return deleter_; }
+
  private:
    T* ptr_;
+   [[no_unique_address]] D deleter_;  // Stateless deleters don't occupy any memory
 
    template< typename U, typename E > friend class unique_ptr;
 };
@@ -261,18 +314,35 @@ class unique_ptr<T[],D>
 template< typename T, typename D >
 constexpr unique_ptr<T[],D>::unique_ptr()
    : ptr_( nullptr )
+   , deleter_()
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>::unique_ptr( T* ptr )
    : ptr_( ptr )
+   , deleter_()
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( T* ptr, D const& d )
+   : ptr_( ptr )
+   , deleter_( d )
+{}
+
+
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( T* ptr, D&& d )
+   : ptr_( ptr )
+   , deleter_( std::move( d ) )
 {}
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -283,6 +353,7 @@ template< typename U, typename E >
    requires pointer_convertible<U[],T[]>  // No constraint for 'E'
 unique_ptr<T[],D>::unique_ptr( unique_ptr<U[],E>&& u ) noexcept
    : ptr_( u.ptr_ )
+   , deleter_( std::move( u.deleter_ ) )
 {
    u.ptr_ = nullptr;
 }
@@ -291,16 +362,17 @@ unique_ptr<T[],D>::unique_ptr( unique_ptr<U[],E>&& u ) noexcept
 template< typename T, typename D >
 unique_ptr<T[],D>::~unique_ptr() noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
 }
 
 
 template< typename T, typename D >
 unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -310,9 +382,10 @@ template< typename U, typename E >
    requires pointer_convertible<U[],T[]>  // No constraint for 'E'
 unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr<U[],E>&& u ) noexcept
 {
-   D{}( ptr_ );
+   deleter_( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
+   deleter_ = std::move( u.deleter_ );
    return *this;
 }
 
@@ -320,7 +393,7 @@ unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr<U[],E>&& u ) noexcep
 template< typename T, typename D >
 void unique_ptr<T[],D>::reset( std::nullptr_t ptr ) noexcept
 {
-   unique_ptr tmp( std::exchange( ptr_, ptr ) );
+   deleter_( std::exchange( ptr_, ptr ) );
 }
 
 
@@ -335,6 +408,7 @@ template< typename T, typename D >
 void unique_ptr<T[],D>::swap( unique_ptr& other ) noexcept
 {
    std::swap( ptr_, other.ptr_ );
+   std::swap( deleter_, other.deleter_ );
 }
 
 
@@ -356,8 +430,302 @@ unique_ptr<T> make_unique( Args&&... args )
 
 
 
+//==== Stateful deleter for memory resources ====
+template< typename T >
+struct resource_delete
+{
+   std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         ptr->~T();
+         resource->deallocate( const_cast<std::remove_cv_t<T>*>( ptr ), sizeof(T), alignof(T) );
+      }
+   }
+};
+
+template< typename T >
+struct resource_delete<T[]>
+{
+   std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };
+   size_t size{ 0U };
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         std::destroy_n( ptr, size );
+         resource->deallocate( const_cast<std::remove_cv_t<T>*>( ptr ), size*sizeof(T), alignof(T) );
+      }
+   }
+};
+
+template< typename T, typename... Args >
+   requires ( !std::is_array_v<T> )
+unique_ptr< T, resource_delete<T> > allocate_unique( std::pmr::memory_resource& resource, Args&&... args )
+{
+   void* const memory = resource.allocate( sizeof(T), alignof(T) );
+
+   try {
+      return unique_ptr< T, resource_delete<T> >(
+         ::new (memory) T( std::forward<Args>(args)... ), resource_delete<T>{ &resource } );
+   }
+   catch( ... ) {
+      resource.deallocate( memory, sizeof(T), alignof(T) );
+      throw;
+   }
+}
+
+template< typename T, typename... Args >
+   requires std::is_unbounded_array_v<T>
+unique_ptr< T, resource_delete<T> > allocate_unique( std::pmr::memory_resource& resource, size_t size
+                                                   , Args const&... args )
+{
+   using U = std::remove_extent_t<T>;
+
+   void* const memory = resource.allocate( size*sizeof(U), alignof(U) );
+   U* const ptr = static_cast<U*>( memory );
+   size_t i{ 0U };
+
+   try {
+      for( ; i<size; ++i ) {
+         ::new (ptr+i) U( args... );
+      }
+      return unique_ptr< T, resource_delete<T> >( ptr, resource_delete<T>{ &resource, size } );
+   }
+   catch( ... ) {
+      std::destroy_n( ptr, i );
+      resource.deallocate( memory, size*sizeof(U), alignof(U) );
+      throw;
+   }
+}
+
+
+
+
+//==== Size guarantees ====
+static_assert( sizeof( unique_ptr<Widget>   ) == sizeof(Widget*) );
+static_assert( sizeof( unique_ptr<Widget[]> ) == sizeof(Widget*) );
+static_assert( sizeof( unique_ptr< Widget, resource_delete<Widget> > ) == 2U*sizeof(Widget*) );
+static_assert( sizeof( unique_ptr< Widget[], resource_delete<Widget[]> > ) == 3U*sizeof(Widget*) );
+
+
+
+
+//---- <poly_vector> ------------------------------------------------------------------------------
+
+// Container for objects of different types derived from 'Base'. All objects are stored within
+// a single contiguous buffer, each one at an offset according to the alignment of its type. An
+// additional array of entries refers to the objects in insertion order. When the buffer grows,
+// the objects are moved to the same offsets within the new buffer, whose alignment is at least
+// the largest alignment of all stored types.
+template< typename Base >
+   requires std::has_virtual_destructor_v<Base>
+class poly_vector
+{
+ private:
+   struct Entry
+   {
+      size_t offset;
+      Base*  base;
+      Base* (*relocate)( std::byte* from, std::byte* to ) noexcept;
+   };
+
+   template< typename B >
+   class basic_iterator
+   {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = std::remove_const_t<B>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = B*;
+      using reference         = B&;
+
+      basic_iterator() = default;
+      explicit basic_iterator( Entry const* entry ) : entry_( entry ) {}
+
+      B& operator*()  const { return *entry_->base; }
+      B* operator->() const { return entry_->base; }
+
+      basic_iterator& operator++() { ++entry_; return *this; }
+      basic_iterator  operator++( int ) { return basic_iterator( entry_++ ); }
+
+      friend bool operator==( basic_iterator, basic_iterator ) = default;
+
+    private:
+      Entry const* entry_{ nullptr };
+   };
+
+ public:
+   using value_type     = Base;
+   using iterator       = basic_iterator<Base>;
+   using const_iterator = basic_iterator<Base const>;
+
+   poly_vector() = default;
+
+   poly_vector( poly_vector const& ) = delete;
+   poly_vector& operator=( poly_vector const& ) = delete;
+
+   poly_vector( poly_vector&& other ) noexcept
+      : buffer_   ( std::exchange( other.buffer_, nullptr ) )
+      , size_     ( std::exchange( other.size_, 0U ) )
+      , capacity_ ( std::exchange( other.capacity_, 0U ) )
+      , alignment_( std::exchange( other.alignment_, alignof(std::max_align_t) ) )
+      , entries_  ( std::move( other.entries_ ) )
+   {
+      other.entries_.clear();
+   }
+
+   poly_vector& operator=( poly_vector&& other ) noexcept
+   {
+      poly_vector tmp( std::move( other ) );
+      swap( tmp );
+      return *this;
+   }
+
+   ~poly_vector()
+   {
+      clear();
+      ::operator delete( buffer_, std::align_val_t{ alignment_ } );
+   }
+
+   size_t size()  const noexcept { return entries_.size(); }
+   bool   empty() const noexcept { return entries_.empty(); }
+
+   // Number of bytes occupied in the buffer (including padding)
+   size_t bytes() const noexcept { return size_; }
+
+   Base&       operator[]( size_t index )       noexcept { return *entries_[index].base; }
+   Base const& operator[]( size_t index ) const noexcept { return *entries_[index].base; }
+
+   iterator       begin()       noexcept { return iterator( entries_.data() ); }
+   const_iterator begin() const noexcept { return const_iterator( entries_.data() ); }
+   iterator       end()         noexcept { return iterator( entries_.data() + entries_.size() ); }
+   const_iterator end()   const noexcept { return const_iterator( entries_.data() + entries_.size() ); }
+
+   // Reserves memory for 'n' elements with a total size of 'bytes' bytes and a maximum
+   // alignment of 'alignment'
+   void reserve( size_t n, size_t bytes, size_t alignment = alignof(std::max_align_t) )
+   {
+      entries_.reserve( n );
+      if( bytes > capacity_ || alignment > alignment_ ) {
+         reallocate( std::max( bytes, capacity_ ), std::max( alignment, alignment_ ) );
+      }
+   }
+
+   template< std::derived_from<Base> Derived, typename... Args >
+      requires std::is_nothrow_move_constructible_v<Derived>
+   Derived& emplace_back( Args&&... args )
+   {
+      size_t const offset = ( size_ + alignof(Derived) - 1U ) & ~( alignof(Derived) - 1U );
+
+      if( offset + sizeof(Derived) > capacity_ || alignof(Derived) > alignment_ ) {
+         reallocate( std::max( { 2U*capacity_, offset + sizeof(Derived), size_t{ 256U } } )
+                   , std::max( alignment_, alignof(Derived) ) );
+      }
+
+      Derived* const object = ::new ( buffer_ + offset ) Derived( std::forward<Args>( args )... );
+
+      try {
+         entries_.push_back( Entry{ offset, object, &relocate<Derived> } );
+      }
+      catch( ... ) {
+         object->~Derived();
+         throw;
+      }
+
+      size_ = offset + sizeof(Derived);
+      return *object;
+   }
+
+   void clear() noexcept
+   {
+      for( Entry const& entry : entries_ ) {
+         entry.base->~Base();
+      }
+      entries_.clear();
+      size_ = 0U;
+   }
+
+   void swap( poly_vector& other ) noexcept
+   {
+      std::swap( buffer_   , other.buffer_    );
+      std::swap( size_     , other.size_      );
+      std::swap( capacity_ , other.capacity_  );
+      std::swap( alignment_, other.alignment_ );
+      entries_.swap( other.entries_ );
+   }
+
+ private:
+   template< typename Derived >
+   static Base* relocate( std::byte* from, std::byte* to ) noexcept
+   {
+      Derived* const source = std::launder( reinterpret_cast<Derived*>( from ) );
+      Derived* const target = ::new ( to ) Derived( std::move( *source ) );
+      source->~Derived();
+      return target;
+   }
+
+   void reallocate( size_t capacity, size_t alignment )
+   {
+      std::byte* const buffer =
+         static_cast<std::byte*>( ::operator new( capacity, std::align_val_t{ alignment } ) );
+
+      for( Entry& entry : entries_ ) {
+         entry.base = entry.relocate( buffer_ + entry.offset, buffer + entry.offset );
+      }
+
+      ::operator delete( buffer_, std::align_val_t{ alignment_ } );
+
+      buffer_    = buffer;
+      capacity_  = capacity;
+      alignment_ = alignment;
+   }
+
+   std::byte* buffer_   { nullptr };
+   size_t     size_     { 0U };
+   size_t     capacity_ { 0U };
+   size_t     alignment_{ alignof(std::max_align_t) };
+
+   std::vector<Entry> entries_;
+};
+
+
+
+
 //---- <Main.cpp> ---------------------------------------------------------------------------------
 
+// Auxiliary widgets of different size and alignment for benchmarking purposes
+class SmallWidget : public WidgetBase
+{
+ public:
+   explicit SmallWidget( int i ) : WidgetBase{i} {}
+};
+
+class LargeWidget : public WidgetBase
+{
+ public:
+   explicit LargeWidget( int i ) : WidgetBase{i} {}
+
+ private:
+   alignas(32) double values_[4]{};
+};
+
+
+// Time in milliseconds for the given operation
+template< typename Operation >
+double benchmark( Operation operation )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   operation();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
 int main()
 {
    // unique_ptr for a single Widget
@@ -450,5 +818,78 @@ int main()
       */
    }
 
+   // unique_ptr with a stateful deleter
+   {
+      std::cout << "\n==== unique_ptr with a stateful deleter ====\n";
+
+      std::pmr::unsynchronized_pool_resource resource{};
+
+      auto a = allocate_unique<Widget>( resource, 1, 1.1 );
+      std::cout << " a has been created (a=" << *a << ")\n";
+
+      auto b = allocate_unique<Widget[]>( resource, 2U, 2, 2.2 );
+      std::cout << " b has been created (b=[" << b[0] << "," << b[1] << "])\n";
+
+      unique_ptr< Widget[], resource_delete<Widget[]> > c{};
+      c.swap( b );
+      std::cout << " b has been swapped with c (deleter: size=" << c.get_deleter().size << ")\n";
+   }
+
+   // poly_vector for different kinds of widgets
+   {
+      std::cout << "\n==== poly_vector for different kinds of widgets ====\n";
+
+      poly_vector<WidgetBase> v{};
+      v.reserve( 3U, 256U, alignof(LargeWidget) );
+      v.emplace_back<Widget>( 1, 1.1 );
+      v.emplace_back<SmallWidget>( 2 );
+      v.emplace_back<LargeWidget>( 3 );
+
+      std::cout << " v has been created (v=[";
+      for( WidgetBase const& w : v ) {
+         std::cout << " " << w.getInt();
+      }
+      std::cout << " ], bytes=" << v.bytes() << ")\n";
+   }
+
+   // Comparison of 'std::vector<unique_ptr<WidgetBase>>' and 'poly_vector<WidgetBase>'
+   {
+      constexpr int N( 1000000 );
+      constexpr int repetitions( 20 );
+      long checksum{};
+
+      std::vector< unique_ptr<WidgetBase> > v1;
+      poly_vector<WidgetBase> v2;
+
+      double const c1 = benchmark( [&]{
+         for( int i=0; i<N; ++i ) {
+            if( i % 2 ) v1.push_back( make_unique<SmallWidget>( i ) );
+            else        v1.push_back( make_unique<LargeWidget>( i ) );
+         }
+      } );
+      double const c2 = benchmark( [&]{
+         for( int i=0; i<N; ++i ) {
+            if( i % 2 ) v2.emplace_back<SmallWidget>( i );
+            else        v2.emplace_back<LargeWidget>( i );
+         }
+      } );
+
+      double const i1 = benchmark( [&]{
+         for( int rep=0; rep<repetitions; ++rep ) {
+            for( auto const& w : v1 ) checksum += w->getInt();
+         }
+      } );
+      double const i2 = benchmark( [&]{
+         for( int rep=0; rep<repetitions; ++rep ) {
+            for( auto const& w : v2 ) checksum += w.getInt();
+         }
+      } );
+
+      std::cout << "\n                                    construction   iteration\n"
+                << " std::vector<unique_ptr<WidgetBase>>" << std::setw(9) << c1 << " ms" << std::setw(9) << i1 << " ms\n"
+                << " poly_vector<WidgetBase>            " << std::setw(9) << c2 << " ms" << std::setw(9) << i2 << " ms\n"
+                << " (checksum " << checksum << ")\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -23,12 +23,36 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
 #include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#  define ACCUMULATE_X86_DISPATCH 1
+#  define ACCUMULATE_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#  define ACCUMULATE_X86_DISPATCH 0
+#  define ACCUMULATE_ALWAYS_INLINE inline
+#endif
+
 
 // Step 1: Implement the 'accumulate()' algorithm. The algorithm should take a pair of iterators,
 //         an initial value for the reduction operation, and a binary operation that performs the
@@ -43,6 +67,173 @@ T accumulate( InputIt first, InputIt last, T init, BinaryOperation op )
    return init;
 }
 
+// Vectorized reduction for contiguous ranges of arithmetic values: The sequential dependency
+// chain of 'init = op( init, *first )' prevents any vectorization. The following kernel instead
+// reduces into several independent accumulators, which the compiler maps onto SIMD registers.
+// Since this changes the order of operations, it is applied automatically only to integral
+// values, for which the result is identical. For floating-point values, reassociation has to be
+// requested explicitly via 'reassociate'.
+enum class Reduction { none, sum, product };
+
+template< typename BinaryOperation, typename T >
+constexpr Reduction reduction_kind = Reduction::none;
+
+template< typename T >
+constexpr Reduction reduction_kind< std::plus<>, T > = Reduction::sum;
+
+template< typename T >
+constexpr Reduction reduction_kind< std::plus<T>, T > = Reduction::sum;
+
+template< typename InputIt, typename T, typename BinaryOperation >
+concept VectorizableReduction =
+   std::contiguous_iterator<InputIt> &&
+   std::same_as< std::iter_value_t<InputIt>, T > &&
+   std::is_arithmetic_v<T> && !std::same_as<T,bool> &&
+   reduction_kind<BinaryOperation,T> != Reduction::none;
+
+struct reassociate_t { explicit reassociate_t() = default; };
+inline constexpr reassociate_t reassociate{};
+
+template< Reduction R, typename T >
+constexpr T combine( T a, T b ) noexcept
+{
+   if constexpr( R == Reduction::sum ) {
+      return static_cast<T>( a + b );
+   }
+   else {
+      return static_cast<T>( a * b );
+   }
+}
+
+#if ACCUMULATE_X86_DISPATCH
+// SIMD kernel based on four independent vector registers of 'Bytes' bytes each
+template< Reduction R, typename T, std::size_t Bytes >
+ACCUMULATE_ALWAYS_INLINE T reduce_vectors( T const* first, T const* last ) noexcept
+{
+   typedef T Vector __attribute__(( vector_size( Bytes ) ));
+
+   constexpr std::size_t L( Bytes / sizeof(T) );
+   constexpr T identity( R == Reduction::sum ? 0 : 1 );
+
+   Vector a0 = Vector{} + identity, a1 = a0, a2 = a0, a3 = a0;
+   Vector x0, x1, x2, x3;
+
+   for( ; static_cast<std::size_t>( last-first ) >= 4U*L; first+=4U*L ) {
+      std::memcpy( &x0, first     , Bytes );
+      std::memcpy( &x1, first+  L , Bytes );
+      std::memcpy( &x2, first+2U*L, Bytes );
+      std::memcpy( &x3, first+3U*L, Bytes );
+      // Vector operations are spelled out to avoid passing vectors across target boundaries
+      if constexpr( R == Reduction::sum ) {
+         a0 += x0; a1 += x1; a2 += x2; a3 += x3;
+      }
+      else {
+         a0 *= x0; a1 *= x1; a2 *= x2; a3 *= x3;
+      }
+   }
+
+   if constexpr( R == Reduction::sum ) {
+      a0 += a1 + a2 + a3;
+   }
+   else {
+      a0 *= a1 * a2 * a3;
+   }
+
+   T result( identity );
+   for( std::size_t i=0U; i<L; ++i ) {
+      result = combine<R>( result, T( a0[i] ) );
+   }
+   for( ; first!=last; ++first ) {
+      result = combine<R>( result, *first );
+   }
+   return result;
+}
+
+// AVX2 kernel (256-bit registers), compiled independently of the target architecture
+template< Reduction R, typename T >
+__attribute__((target("avx2"))) T reduce_avx2( T const* first, T const* last ) noexcept
+{
+   return reduce_vectors<R,T,32U>( first, last );
+}
+
+inline bool has_avx2() noexcept
+{
+   static bool const avx2 = __builtin_cpu_supports( "avx2" );
+   return avx2;
+}
+
+// Runtime dispatch between the AVX2 kernel and the SSE2 kernel (128-bit registers)
+template< Reduction R, typename T >
+T reduce_simd( T const* first, T const* last ) noexcept
+{
+   if( has_avx2() ) {
+      return reduce_avx2<R>( first, last );
+   }
+   return reduce_vectors<R,T,16U>( first, last );
+}
+#else
+// Portable kernel based on independent accumulators, which the compiler may vectorize
+template< Reduction R, typename T >
+T reduce_simd( T const* first, T const* last ) noexcept
+{
+   constexpr std::size_t L( 64U / sizeof(T) );
+   constexpr T identity( R == Reduction::sum ? 0 : 1 );
+
+   T acc[L];
+   std::fill_n( acc, L, identity );
+
+   for( ; static_cast<std::size_t>( last-first ) >= L; first+=L ) {
+      for( std::size_t i=0U; i<L; ++i ) {
+         acc[i] = combine<R>( acc[i], first[i] );
+      }
+   }
+
+   T result( identity );
+   for( std::size_t i=0U; i<L; ++i ) {
+      result = combine<R>( result, acc[i] );
+   }
+   for( ; first!=last; ++first ) {
+      result = combine<R>( result, *first );
+   }
+   return result;
+}
+#endif
+
+template< typename InputIt, typename T, typename BinaryOperation >
+T accumulate_simd( InputIt first, InputIt last, T init, BinaryOperation )
+{
+   constexpr Reduction R( reduction_kind<BinaryOperation,T> );
+
+   // Integral values are reduced in the corresponding unsigned type, whose wrap-around
+   // arithmetic is associative and avoids signed overflow in reordered partial results
+   using U = typename std::conditional_t< std::is_integral_v<T>
+                                        , std::make_unsigned<T>
+                                        , std::type_identity<T> >::type;
+
+   U const* const begin = reinterpret_cast<U const*>( std::to_address( first ) );
+   U const* const end   = begin + ( last - first );
+
+   return static_cast<T>( combine<R>( static_cast<U>( init ), reduce_simd<R>( begin, end ) ) );
+}
+
+template< typename InputIt, typename T, typename BinaryOperation >
+   requires VectorizableReduction<InputIt,T,BinaryOperation> && std::integral<T>
+T accumulate( InputIt first, InputIt last, T init, BinaryOperation op )
+{
+   return accumulate_simd( first, last, init, op );
+}
+
+template< typename InputIt, typename T, typename BinaryOperation >
+T accumulate( reassociate_t, InputIt first, InputIt last, T init, BinaryOperation op )
+{
+   if constexpr( VectorizableReduction<InputIt,T,BinaryOperation> ) {
+      return accumulate_simd( first, last, init, op );
+   }
+   else {
+      return accumulate( first, last, init, op );
+   }
+}
+
 // Step 2: Implement an overload of the 'accumulate()' algorithm that uses 'std::plus' as the
 //         default binary operation.
 template< typename InputIt, typename T >
@@ -71,6 +262,226 @@ struct Times
    }
 };
 
+template< typename T >
+constexpr Reduction reduction_kind< Times, T > = Reduction::product;
+
+
+// Thread pool with one task queue per worker. Every worker processes its own queue in LIFO order
+// and, once it runs dry, steals from the front of the other queues. Threads waiting for the
+// completion of tasks can help via 'run_pending_task()' instead of blocking.
+class ThreadPool
+{
+ public:
+   explicit ThreadPool( std::size_t threads = std::thread::hardware_concurrency() )
+      : queues_( std::max<std::size_t>( threads, 1U ) )
+   {
+      threads_.reserve( queues_.size() );
+      for( std::size_t i=0U; i<queues_.size(); ++i ) {
+         threads_.emplace_back( [this,i]{ work( i ); } );
+      }
+   }
+
+   ThreadPool( ThreadPool const& ) = delete;
+   ThreadPool& operator=( ThreadPool const& ) = delete;
+
+   ~ThreadPool()
+   {
+      {
+         std::scoped_lock lock( mutex_ );
+         done_ = true;
+      }
+      cv_.notify_all();
+      for( std::thread& thread : threads_ ) {
+         thread.join();
+      }
+   }
+
+   std::size_t size() const noexcept { return threads_.size(); }
+
+   void submit( std::function<void()> task )
+   {
+      // Tasks of a worker are kept local, all other tasks are distributed round robin
+      std::size_t const index = ( current_pool_ == this )
+                              ? current_index_
+                              : next_.fetch_add( 1U, std::memory_order_relaxed ) % queues_.size();
+      {
+         std::scoped_lock lock( queues_[index].mutex );
+         queues_[index].tasks.push_back( std::move( task ) );
+      }
+      {
+         std::scoped_lock lock( mutex_ );
+         ++pending_;
+      }
+      cv_.notify_one();
+   }
+
+   // Executes a single pending task, if any; returns whether a task was executed
+   bool run_pending_task()
+   {
+      std::function<void()> task;
+      std::size_t const index = ( current_pool_ == this ) ? current_index_ : 0U;
+      if( !pop( index, task ) ) {
+         return false;
+      }
+      task();
+      return true;
+   }
+
+ private:
+   struct Queue
+   {
+      std::mutex mutex;
+      std::deque< std::function<void()> > tasks;
+   };
+
+   void work( std::size_t index )
+   {
+      current_pool_  = this;
+      current_index_ = index;
+
+      std::function<void()> task;
+      while( true ) {
+         if( pop( index, task ) ) {
+            task();
+            continue;
+         }
+
+         std::unique_lock lock( mutex_ );
+         cv_.wait( lock, [this]{ return done_ || pending_ > 0U; } );
+         if( done_ && pending_ == 0U ) {
+            return;
+         }
+      }
+   }
+
+   // Takes a task from the back of the given queue or steals from the front of another queue
+   bool pop( std::size_t index, std::function<void()>& task )
+   {
+      for( std::size_t i=0U; i<queues_.size(); ++i )
+      {
+         Queue& queue = queues_[(index+i) % queues_.size()];
+         std::scoped_lock lock( queue.mutex );
+
+         if( !queue.tasks.empty() )
+         {
+            if( i == 0U ) {
+               task = std::move( queue.tasks.back() );
+               queue.tasks.pop_back();
+            }
+            else {
+               task = std::move( queue.tasks.front() );
+               queue.tasks.pop_front();
+            }
+
+            std::scoped_lock counter( mutex_ );
+            --pending_;
+            return true;
+         }
+      }
+      return false;
+   }
+
+   std::deque<Queue> queues_;
+   std::vector<std::thread> threads_;
+   std::atomic<std::size_t> next_{};
+
+   std::mutex mutex_;
+   std::condition_variable cv_;
+   std::size_t pending_{};
+   bool done_{};
+
+   static inline thread_local ThreadPool* current_pool_{};
+   static inline thread_local std::size_t current_index_{};
+};
+
+inline ThreadPool& default_thread_pool()
+{
+   static ThreadPool pool{};
+   return pool;
+}
+
+
+// Minimum number of elements per task; smaller ranges are reduced serially
+inline constexpr std::size_t parallel_grain_size( 16384U );
+
+// Parallel reduction of random-access ranges: The range is split into chunks, which are reduced
+// independently on the given thread pool. The partial results are finally combined in order via
+// 'op', which therefore has to be associative (but not necessarily commutative). Since no
+// identity element is known for arbitrary operations (e.g. 'Times'), every chunk is seeded with
+// its first element.
+template< typename RandomIt, typename T, typename BinaryOperation >
+   requires std::random_access_iterator<RandomIt>
+T parallel_accumulate( ThreadPool& pool, RandomIt first, RandomIt last, T init, BinaryOperation op )
+{
+   std::size_t const size = static_cast<std::size_t>( last - first );
+
+   if( size < 2U*parallel_grain_size || pool.size() < 2U ) {
+      return accumulate( first, last, std::move(init), op );
+   }
+
+   // A few chunks per thread give the work stealing room to balance the load
+   std::size_t const chunks = std::min( size / parallel_grain_size, 4U*pool.size() );
+
+   std::vector< std::optional<T> > partials( chunks );
+   std::vector< std::exception_ptr > errors( chunks );
+   std::atomic<std::size_t> remaining( chunks );
+
+   for( std::size_t i=0U; i<chunks; ++i )
+   {
+      RandomIt const begin = first + static_cast<std::ptrdiff_t>( i*size/chunks );
+      RandomIt const end   = first + static_cast<std::ptrdiff_t>( (i+1U)*size/chunks );
+
+      pool.submit( [&,i,begin,end]{
+         try {
+            partials[i].emplace( accumulate( std::next(begin), end, T( *begin ), op ) );
+         }
+         catch( ... ) {
+            errors[i] = std::current_exception();
+         }
+         remaining.fetch_sub( 1U, std::memory_order_release );
+      } );
+   }
+
+   // The calling thread helps processing the chunks (which also avoids deadlocks in case
+   // 'parallel_accumulate()' is called from within a task of the same pool)
+   while( remaining.load( std::memory_order_acquire ) > 0U ) {
+      if( !pool.run_pending_task() ) {
+         std::this_thread::yield();
+      }
+   }
+
+   for( std::size_t i=0U; i<chunks; ++i ) {
+      if( errors[i] ) {
+         std::rethrow_exception( errors[i] );
+      }
+      init = op( std::move(init), std::move( *partials[i] ) );
+   }
+   return init;
+}
+
+template< typename RandomIt, typename T, typename BinaryOperation >
+   requires std::random_access_iterator<RandomIt>
+T parallel_accumulate( RandomIt first, RandomIt last, T init, BinaryOperation op )
+{
+   return parallel_accumulate( default_thread_pool(), first, last, std::move(init), op );
+}
+
+
+// Time in milliseconds for the given reduction
+template< typename Reduce >
+double benchmark( Reduce reduce, std::size_t repetitions )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( std::size_t rep=0U; rep<repetitions; ++rep ) {
+      reduce();
+   }
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
 
 int main()
 {
@@ -88,5 +499,76 @@ int main()
       std::cout << "\n sum = " << sum << "\n\n";
    }
 
+   // Explicitly reassociated product of values in a vector of floating-point values
+   {
+      const std::vector<double> v{ 1.1, 3.3, 5.5, 7.7 };
+      const auto sum = accumulate( reassociate, begin(v), end(v), double{1}, Times{} );
+      std::cout << "\n sum = " << sum << "\n\n";
+   }
+
+   // Comparison of the sequential and the vectorized reduction
+   {
+      constexpr std::size_t N( 1UL << 20 );
+      constexpr std::size_t repetitions( 100U );
+
+      std::vector<int> vi( N );
+      std::vector<double> vd( N );
+      for( std::size_t i=0U; i<N; ++i ) {
+         vi[i] = static_cast<int>( i % 100U );
+         vd[i] = static_cast<double>( i % 100U );
+      }
+
+      auto const plus = []( auto a, auto b ){ return a + b; };  // Not detected as 'std::plus'
+      volatile int si{};
+      volatile double sd{};
+
+      double const t1 = benchmark( [&]{ si = accumulate( begin(vi), end(vi), 0, plus ); }, repetitions );
+      double const t2 = benchmark( [&]{ si = accumulate( begin(vi), end(vi), 0, std::plus<>{} ); }, repetitions );
+      double const t3 = benchmark( [&]{ sd = accumulate( begin(vd), end(vd), 0.0, std::plus<>{} ); }, repetitions );
+      double const t4 = benchmark( [&]{ sd = accumulate( reassociate, begin(vd), end(vd), 0.0, std::plus<>{} ); }, repetitions );
+
+      std::cout << " int    sequential: " << t1 << " ms\n"
+                << " int    vectorized: " << t2 << " ms\n"
+                << " double sequential: " << t3 << " ms\n"
+                << " double vectorized: " << t4 << " ms (reassociated)\n\n";
+   }
+
+   // Parallel product of values in a vector of floating-point values
+   {
+      const std::vector<double> v( 100000U, 1.0001 );
+      const auto product = parallel_accumulate( begin(v), end(v), double{1}, Times{} );
+      std::cout << " product = " << product << "\n\n";
+   }
+
+   // Scaling of the parallel reduction from 1 to N threads
+   {
+      constexpr std::size_t N( 1UL << 22 );
+      constexpr std::size_t repetitions( 20U );
+
+      std::vector<double> v( N );
+      for( std::size_t i=0U; i<N; ++i ) {
+         v[i] = static_cast<double>( i % 100U );
+      }
+
+      auto const plus = []( double a, double b ){ return a + b; };
+      volatile double sum{};
+
+      double const serial = benchmark( [&]{ sum = accumulate( begin(v), end(v), 0.0, plus ); }, repetitions );
+
+      std::cout << " Threads       Time   Speedup\n"
+                << std::setw(8) << "serial" << std::setw(8) << serial << " ms" << std::setw(10) << 1.0 << "\n";
+
+      std::size_t const cores = std::max( std::thread::hardware_concurrency(), 1U );
+      for( std::size_t threads=1U; ; threads=std::min( 2U*threads, cores ) )
+      {
+         ThreadPool pool( threads );
+         double const time = benchmark( [&]{ sum = parallel_accumulate( pool, begin(v), end(v), 0.0, plus ); }, repetitions );
+
+         std::cout << std::setw(8) << threads << std::setw(8) << time << " ms" << std::setw(10) << serial/time << "\n";
+         if( threads == cores ) break;
+      }
+      std::cout << "\n";
+   }
+
    return EXIT_SUCCESS;
 }
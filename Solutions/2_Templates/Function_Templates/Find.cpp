@@ -15,12 +15,28 @@
 *
 **************************************************************************************************/
 
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#  include <immintrin.h>
+#  define FIND_X86_DISPATCH 1
+#else
+#  define FIND_X86_DISPATCH 0
+#endif
+
 using namespace std::string_literals;
 
 
@@ -35,6 +51,134 @@ InputIterator find( InputIterator first, InputIterator last, const Type& value )
 }
 
 
+// Vectorized search in contiguous ranges of integral values: Instead of comparing one element
+// at a time, a complete SIMD register of elements is compared against the broadcast value and
+// the resulting mask is condensed into a bit mask, whose lowest set bit marks the first match.
+// Single bytes are searched via 'memchr()', which is already implemented in this way.
+template< typename T, typename Type >
+concept VectorizableFind =
+   std::integral<T> && !std::same_as<T,bool> &&
+   ( sizeof(T) == 1U || sizeof(T) == 2U || sizeof(T) == 4U || sizeof(T) == 8U ) &&
+   std::integral<Type>;
+
+template< typename T >
+T const* find_scalar( T const* first, T const* last, T value ) noexcept
+{
+   for( ; first!=last; ++first ) {
+      if( *first == value )
+         return first;
+   }
+   return last;
+}
+
+#if FIND_X86_DISPATCH
+// SSE2 kernel (128-bit registers), which is available on every x86-64 CPU
+template< typename T >
+T const* find_sse2( T const* first, T const* last, T value ) noexcept
+{
+   constexpr std::size_t L( 16U / sizeof(T) );
+
+   __m128i needle;
+   if constexpr( sizeof(T) == 2U ) needle = _mm_set1_epi16( std::bit_cast<std::int16_t>( value ) );
+   if constexpr( sizeof(T) == 4U ) needle = _mm_set1_epi32( std::bit_cast<std::int32_t>( value ) );
+   if constexpr( sizeof(T) == 8U ) needle = _mm_set1_epi64x( std::bit_cast<std::int64_t>( value ) );
+
+   for( ; static_cast<std::size_t>( last-first ) >= L; first+=L )
+   {
+      __m128i const block = _mm_loadu_si128( reinterpret_cast<__m128i const*>( first ) );
+
+      __m128i equal;
+      if constexpr( sizeof(T) == 2U ) equal = _mm_cmpeq_epi16( block, needle );
+      if constexpr( sizeof(T) == 4U ) equal = _mm_cmpeq_epi32( block, needle );
+      if constexpr( sizeof(T) == 8U ) {
+         // SSE2 lacks a 64-bit comparison: Both 32-bit halves have to be equal
+         equal = _mm_cmpeq_epi32( block, needle );
+         equal = _mm_and_si128( equal, _mm_shuffle_epi32( equal, _MM_SHUFFLE(2,3,0,1) ) );
+      }
+
+      if( unsigned const mask = static_cast<unsigned>( _mm_movemask_epi8( equal ) ) ) {
+         return first + std::countr_zero( mask ) / sizeof(T);
+      }
+   }
+   return find_scalar( first, last, value );
+}
+
+// AVX2 kernel (256-bit registers), compiled independently of the target architecture
+template< typename T >
+__attribute__((target("avx2"))) T const* find_avx2( T const* first, T const* last, T value ) noexcept
+{
+   constexpr std::size_t L( 32U / sizeof(T) );
+
+   __m256i needle;
+   if constexpr( sizeof(T) == 2U ) needle = _mm256_set1_epi16( std::bit_cast<std::int16_t>( value ) );
+   if constexpr( sizeof(T) == 4U ) needle = _mm256_set1_epi32( std::bit_cast<std::int32_t>( value ) );
+   if constexpr( sizeof(T) == 8U ) needle = _mm256_set1_epi64x( std::bit_cast<std::int64_t>( value ) );
+
+   for( ; static_cast<std::size_t>( last-first ) >= L; first+=L )
+   {
+      __m256i const block = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( first ) );
+
+      __m256i equal;
+      if constexpr( sizeof(T) == 2U ) equal = _mm256_cmpeq_epi16( block, needle );
+      if constexpr( sizeof(T) == 4U ) equal = _mm256_cmpeq_epi32( block, needle );
+      if constexpr( sizeof(T) == 8U ) equal = _mm256_cmpeq_epi64( block, needle );
+
+      if( unsigned const mask = static_cast<unsigned>( _mm256_movemask_epi8( equal ) ) ) {
+         return first + std::countr_zero( mask ) / sizeof(T);
+      }
+   }
+   return find_scalar( first, last, value );
+}
+
+inline bool has_avx2() noexcept
+{
+   static bool const avx2 = __builtin_cpu_supports( "avx2" );
+   return avx2;
+}
+#endif
+
+template< typename T >
+T const* find_simd( T const* first, T const* last, T value ) noexcept
+{
+   if constexpr( sizeof(T) == 1U ) {
+      if( first == last ) return last;  // 'memchr()' requires a valid pointer
+      void const* const pos = std::memchr( first, static_cast<unsigned char>( value ), last-first );
+      return pos ? static_cast<T const*>( pos ) : last;
+   }
+#if FIND_X86_DISPATCH
+   else if( has_avx2() ) {
+      return find_avx2( first, last, value );
+   }
+   else {
+      return find_sse2( first, last, value );
+   }
+#else
+   else {
+      return find_scalar( first, last, value );
+   }
+#endif
+}
+
+template< typename InputIterator, typename Type >
+   requires std::contiguous_iterator<InputIterator>
+         && VectorizableFind< std::iter_value_t<InputIterator>, Type >
+InputIterator find( InputIterator first, InputIterator last, const Type& value )
+{
+   using T = std::iter_value_t<InputIterator>;
+
+   // A value that does not survive the round trip through the element type cannot compare
+   // equal to any element; all other values compare equal to exactly their converted value
+   if( static_cast<Type>( static_cast<T>( value ) ) != value ) {
+      return last;
+   }
+
+   T const* const begin = std::to_address( first );
+   T const* const end   = begin + ( last - first );
+
+   return first + ( find_simd( begin, end, static_cast<T>( value ) ) - begin );
+}
+
+
 template< typename InputIterator, typename UnaryPredicate >
 InputIterator find_if( InputIterator first, InputIterator last, UnaryPredicate p )
 {
@@ -46,6 +190,71 @@ InputIterator find_if( InputIterator first, InputIterator last, UnaryPredicate p
 }
 
 
+// Average time in microseconds to find the given value in the given range
+template< typename Find >
+double benchmark( Find find, std::size_t repetitions, std::size_t& checksum )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( std::size_t rep=0U; rep<repetitions; ++rep ) {
+      checksum += find();
+   }
+   std::chrono::duration<double,std::micro> const time = Clock::now() - start;
+
+   return time.count() / repetitions;
+}
+
+
+// Comparison of the element-wise and the vectorized search for hits at different positions
+template< typename T >
+void benchmark_find( char const* type, std::size_t& checksum )
+{
+   std::cout << " " << type << "\n"
+             << "     Bytes    Hit   Element-wise    Vectorized\n";
+
+   for( std::size_t bytes : { 4096UL, 65536UL, 1UL << 20, 16UL << 20 } )
+   {
+      std::size_t const n = bytes / sizeof(T);
+      std::size_t const repetitions = std::max<std::size_t>( ( 64UL << 20 ) / bytes, 4U );
+
+      std::vector<T> v( n );
+      for( std::size_t i=0U; i<n; ++i ) {
+         v[i] = static_cast<T>( i % 100U );
+      }
+
+      for( std::size_t percent : { 10U, 50U, 100U } )
+      {
+         // A unique value at the given position; 100% denotes a miss
+         T const needle = static_cast<T>( 101 );
+         if( percent < 100U ) {
+            v[n*percent/100U] = needle;
+         }
+
+         auto const element = [&]{
+            return static_cast<std::size_t>( ::find_if( begin(v), end(v), [needle]( T t ){ return t == needle; } ) - begin(v) );
+         };
+         auto const vectorized = [&]{
+            return static_cast<std::size_t>( ::find( begin(v), end(v), needle ) - begin(v) );
+         };
+
+         double const t1 = benchmark( element, repetitions, checksum );
+         double const t2 = benchmark( vectorized, repetitions, checksum );
+
+         std::cout << std::setw(10) << bytes
+                   << std::setw(6)  << ( percent < 100U ? std::to_string(percent) + "%" : "miss"s )
+                   << std::setw(12) << t1 << " us"
+                   << std::setw(11) << t2 << " us\n";
+
+         if( percent < 100U ) {
+            v[n*percent/100U] = static_cast<T>( n*percent/100U % 100U );
+         }
+      }
+   }
+   std::cout << "\n";
+}
+
+
 int main()
 {
    std::vector<int> v{ 3, 5, 2, 7, 5, 4, 3 };
@@ -93,5 +302,24 @@ int main()
       }
    }
 
+   // Find a character in a std::string via the 'memchr()' fast path
+   {
+      std::string const s( "Bjarne Stroustrup" );
+      auto it = ::find( begin(s), end(s), 'S' );
+
+      if( it != end(s) ) {
+         std::cout << "Found 'S' at position " << ( it - begin(s) ) << " in the string!\n\n";
+      }
+   }
+
+   // Comparison of the element-wise and the vectorized search
+   {
+      std::size_t checksum{};
+      benchmark_find<char>( "char", checksum );
+      benchmark_find<int>( "int", checksum );
+      benchmark_find<std::int64_t>( "int64_t", checksum );
+      std::cout << " (checksum " << checksum << ")\n";
+   }
+
    return EXIT_SUCCESS;
 }
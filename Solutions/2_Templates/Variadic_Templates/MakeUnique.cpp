@@ -12,11 +12,25 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <iomanip>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if __has_include(<sys/resource.h>)
+#  include <sys/resource.h>
+#  define MAKEUNIQUE_HAS_RUSAGE 1
+#else
+#  define MAKEUNIQUE_HAS_RUSAGE 0
+#endif
 
 
 //---- <Widget.h> ---------------------------------------------------------------------------------
@@ -53,8 +67,31 @@ class Widget
 
 //---- <memory> -----------------------------------------------------------------------------------
 
-// Simplified implementation of the std::unique_ptr class template
+// Simplified implementation of the 'default_delete' policy
+template< typename T >
+struct default_delete
+{
+   constexpr default_delete() noexcept = default;
+
+   template< typename U
+           , std::enable_if_t< std::is_convertible<U*,T*>::value >* = nullptr >
+   default_delete( default_delete<U> const& ) noexcept {}
+
+   void operator()( T* ptr ) const { delete ptr; }
+};
+
 template< typename T >
+struct default_delete<T[]>
+{
+   template< typename U >
+   void operator()( U* ptr ) const { delete[] ptr; }
+};
+
+
+
+
+// Simplified implementation of the std::unique_ptr class template
+template< typename T, typename D = default_delete<T> >
 class unique_ptr
 {
  public:
@@ -65,78 +102,86 @@ class unique_ptr
              unique_ptr( unique_ptr const& u ) = delete;
              unique_ptr( unique_ptr&& u ) noexcept;
 
-   template< typename U >
-   unique_ptr( unique_ptr<U>&& u ) noexcept;
+   // Conversions require a compatible deleter, i.e. an 'arena_ptr' or 'aligned_ptr' cannot be
+   // converted to a 'unique_ptr' that would release the memory via 'delete'
+   template< typename U, typename E >
+      requires ( std::is_convertible_v<U*,T*> && std::is_convertible_v<E,D> )
+   unique_ptr( unique_ptr<U,E>&& u ) noexcept;
 
    ~unique_ptr() noexcept;
 
    unique_ptr& operator=( unique_ptr const& u ) = delete;
    unique_ptr& operator=( unique_ptr&& u ) noexcept;
 
-   template< typename U >
-   unique_ptr& operator=( unique_ptr<U>&& u ) noexcept;
+   template< typename U, typename E >
+      requires ( std::is_convertible_v<U*,T*> && std::is_convertible_v<E,D> )
+   unique_ptr& operator=( unique_ptr<U,E>&& u ) noexcept;
 
    T& operator*()  const { return *ptr_; }
    T* operator->() const { return ptr_;  }
 
+   T* get() const noexcept { return ptr_; }
+
  private:
    T* ptr_;
 
-   template< typename U > friend class unique_ptr;
+   template< typename U, typename E > friend class unique_ptr;
 };
 
 
-template< typename T >
-constexpr unique_ptr<T>::unique_ptr()
+template< typename T, typename D >
+constexpr unique_ptr<T,D>::unique_ptr()
    : ptr_( nullptr )
 {}
 
 
-template< typename T >
-unique_ptr<T>::unique_ptr( T* ptr )
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( T* ptr )
    : ptr_( ptr )
 {}
 
 
-template< typename T >
-unique_ptr<T>::unique_ptr( unique_ptr&& u ) noexcept
+template< typename T, typename D >
+unique_ptr<T,D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
 {
    u.ptr_ = nullptr;
 }
 
 
-template< typename T >
-template< typename U >
-unique_ptr<T>::unique_ptr( unique_ptr<U>&& u ) noexcept
+template< typename T, typename D >
+template< typename U, typename E >
+   requires ( std::is_convertible_v<U*,T*> && std::is_convertible_v<E,D> )
+unique_ptr<T,D>::unique_ptr( unique_ptr<U,E>&& u ) noexcept
    : ptr_( u.ptr_ )
 {
    u.ptr_ = nullptr;
 }
 
 
-template< typename T >
-unique_ptr<T>::~unique_ptr() noexcept
+template< typename T, typename D >
+unique_ptr<T,D>::~unique_ptr() noexcept
 {
-   delete ptr_;
+   D{}( ptr_ );
 }
 
 
-template< typename T >
-unique_ptr<T>& unique_ptr<T>::operator=( unique_ptr&& u ) noexcept
+template< typename T, typename D >
+unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr&& u ) noexcept
 {
-   delete ptr_;
+   D{}( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
    return *this;
 }
 
 
-template< typename T >
-template< typename U >
-unique_ptr<T>& unique_ptr<T>::operator=( unique_ptr<U>&& u ) noexcept
+template< typename T, typename D >
+template< typename U, typename E >
+   requires ( std::is_convertible_v<U*,T*> && std::is_convertible_v<E,D> )
+unique_ptr<T,D>& unique_ptr<T,D>::operator=( unique_ptr<U,E>&& u ) noexcept
 {
-   delete ptr_;
+   D{}( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
    return *this;
@@ -154,8 +199,8 @@ unique_ptr<T> make_unique( Ts&&... params )
 
 
 
-template< typename T >
-class unique_ptr<T[]>
+template< typename T, typename D >
+class unique_ptr<T[],D>
 {
  public:
    using pointer = T*;
@@ -172,42 +217,44 @@ class unique_ptr<T[]>
 
    T& operator[]( size_t index ) const { return ptr_[index]; }
 
+   T* get() const noexcept { return ptr_; }
+
  private:
    T* ptr_;
 };
 
 
-template< typename T >
-constexpr unique_ptr<T[]>::unique_ptr()
+template< typename T, typename D >
+constexpr unique_ptr<T[],D>::unique_ptr()
    : ptr_( nullptr )
 {}
 
 
-template< typename T >
-unique_ptr<T[]>::unique_ptr( T* ptr )
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( T* ptr )
    : ptr_( ptr )
 {}
 
 
-template< typename T >
-unique_ptr<T[]>::unique_ptr( unique_ptr&& u ) noexcept
+template< typename T, typename D >
+unique_ptr<T[],D>::unique_ptr( unique_ptr&& u ) noexcept
    : ptr_( u.ptr_ )
 {
    u.ptr_ = nullptr;
 }
 
 
-template< typename T >
-unique_ptr<T[]>::~unique_ptr() noexcept
+template< typename T, typename D >
+unique_ptr<T[],D>::~unique_ptr() noexcept
 {
-   delete[] ptr_;
+   D{}( ptr_ );
 }
 
 
-template< typename T >
-unique_ptr<T[]>& unique_ptr<T[]>::operator=( unique_ptr&& u ) noexcept
+template< typename T, typename D >
+unique_ptr<T[],D>& unique_ptr<T[],D>::operator=( unique_ptr&& u ) noexcept
 {
-   delete[] ptr_;
+   D{}( ptr_ );
    ptr_ = u.ptr_;
    u.ptr_ = nullptr;
    return *this;
@@ -224,8 +271,263 @@ unique_ptr<T> make_unique( size_t size )
 
 
 
+// The 'make_unique_for_overwrite()' functions default-initialize instead of value-initialize,
+// i.e. objects of fundamental type are left uninitialized. This avoids zero-filling (and thus
+// touching) memory that is overwritten immediately anyway.
+template< typename T
+        , std::enable_if_t< !std::is_array<T>::value >* = nullptr >
+unique_ptr<T> make_unique_for_overwrite()
+{
+   return unique_ptr<T>( new T );
+}
+
+template< typename T
+        , std::enable_if_t< std::is_array<T>::value >* = nullptr >
+unique_ptr<T> make_unique_for_overwrite( size_t size )
+{
+   return unique_ptr<T>( new typename std::remove_extent<T>::type[size] );
+}
+
+
+
+
+// Deleter for objects allocated with an extended alignment via 'make_aligned_unique_for_overwrite()'
+template< typename T, size_t Alignment >
+struct aligned_delete
+{
+   constexpr aligned_delete() noexcept = default;
+
+   template< typename U
+           , std::enable_if_t< std::is_convertible<U*,T*>::value >* = nullptr >
+   aligned_delete( aligned_delete<U,Alignment> const& ) noexcept {}
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         ptr->~T();
+         ::operator delete( const_cast<std::remove_cv_t<T>*>( ptr ), std::align_val_t{ Alignment } );
+      }
+   }
+};
+
+// Since the number of elements is not stored, arrays are restricted to trivially destructible
+// element types (which is the common case for SIMD and DMA buffers)
+template< typename T, size_t Alignment >
+struct aligned_delete<T[],Alignment>
+{
+   static_assert( std::is_trivially_destructible<T>::value, "Non-trivially destructible type detected" );
+
+   template< typename U >
+   void operator()( U* ptr ) const noexcept
+   {
+      ::operator delete[]( const_cast<std::remove_cv_t<U>*>( ptr ), std::align_val_t{ Alignment } );
+   }
+};
+
+template< typename T, size_t Alignment = 64U >
+using aligned_ptr = unique_ptr< T, aligned_delete<T,Alignment> >;
+
+
+// Variants of 'make_unique_for_overwrite()' for memory with the given alignment, e.g. 64 bytes
+// for cache lines, SIMD registers and DMA transfers
+template< typename T
+        , size_t Alignment = 64U
+        , std::enable_if_t< !std::is_array<T>::value >* = nullptr >
+aligned_ptr<T,Alignment> make_aligned_unique_for_overwrite()
+{
+   static_assert( Alignment >= alignof(T) && ( Alignment & (Alignment-1U) ) == 0U, "Invalid alignment" );
+
+   void* const memory = ::operator new( sizeof(T), std::align_val_t{ Alignment } );
+
+   try {
+      return aligned_ptr<T,Alignment>( ::new (memory) T );
+   }
+   catch( ... ) {
+      ::operator delete( memory, std::align_val_t{ Alignment } );
+      throw;
+   }
+}
+
+template< typename T
+        , size_t Alignment = 64U
+        , std::enable_if_t< std::is_array<T>::value >* = nullptr >
+aligned_ptr<T,Alignment> make_aligned_unique_for_overwrite( size_t size )
+{
+   using U = typename std::remove_extent<T>::type;
+
+   static_assert( Alignment >= alignof(U) && ( Alignment & (Alignment-1U) ) == 0U, "Invalid alignment" );
+
+   void* const memory = ::operator new[]( size*sizeof(U), std::align_val_t{ Alignment } );
+
+   // Trivially destructible types have no array cookie and their default initialization
+   // cannot throw
+   U* const ptr = static_cast<U*>( memory );
+   std::uninitialized_default_construct_n( ptr, size );
+   return aligned_ptr<T,Alignment>( ptr );
+}
+
+
+
+
+//---- <Arena.h> ----------------------------------------------------------------------------------
+
+// Monotonic bump-pointer arena. Memory is handed out by advancing a pointer within large blocks
+// and individual deallocations are no-ops. All memory is released at once, either explicitly
+// via 'release()' or by the destructor of the arena.
+class Arena
+{
+ public:
+   explicit Arena( size_t blockSize = 65536U )
+      : blockSize_( blockSize )
+   {}
+
+   Arena( Arena const& ) = delete;
+   Arena& operator=( Arena const& ) = delete;
+
+   ~Arena()
+   {
+      release();
+   }
+
+   void* allocate( size_t bytes, size_t alignment = alignof(std::max_align_t) )
+   {
+      void* ptr = current_;
+      size_t space = end_ - current_;
+
+      if( !std::align( alignment, bytes, ptr, space ) ) {
+         addBlock( bytes + alignment );
+         ptr = current_;
+         space = end_ - current_;
+         std::align( alignment, bytes, ptr, space );
+      }
+
+      current_ = static_cast<std::byte*>( ptr ) + bytes;
+      return ptr;
+   }
+
+   // Releases all memory; all objects allocated from the arena must have been destroyed
+   void release() noexcept
+   {
+      while( blocks_ ) {
+         ::operator delete( std::exchange( blocks_, blocks_->next ) );
+      }
+      current_ = nullptr;
+      end_     = nullptr;
+   }
+
+ private:
+   struct Block
+   {
+      Block* next;
+   };
+
+   void addBlock( size_t minBytes )
+   {
+      size_t const size = std::max( blockSize_, sizeof(Block) + minBytes );
+
+      Block* const block = static_cast<Block*>( ::operator new( size ) );
+      block->next = blocks_;
+      blocks_  = block;
+      current_ = reinterpret_cast<std::byte*>( block + 1 );
+      end_     = reinterpret_cast<std::byte*>( block ) + size;
+   }
+
+   size_t     blockSize_;
+   Block*     blocks_ { nullptr };
+   std::byte* current_{ nullptr };
+   std::byte* end_    { nullptr };
+};
+
+
+// Deleter for objects living in an 'Arena'. The object is destroyed, but its memory is only
+// reclaimed together with the entire arena.
+template< typename T >
+struct arena_delete
+{
+   constexpr arena_delete() noexcept = default;
+
+   template< typename U
+           , std::enable_if_t< std::is_convertible<U*,T*>::value >* = nullptr >
+   arena_delete( arena_delete<U> const& ) noexcept {}
+
+   void operator()( T* ptr ) const noexcept
+   {
+      if( ptr ) {
+         ptr->~T();
+      }
+   }
+};
+
+template< typename T >
+using arena_ptr = unique_ptr< T, arena_delete<T> >;
+
+
+// Arena-aware variant of 'make_unique()', constructing the object within the given arena
+template< typename T
+        , typename... Ts
+        , std::enable_if_t< !std::is_array<T>::value >* = nullptr >
+arena_ptr<T> make_arena_unique( Arena& arena, Ts&&... params )
+{
+   void* const memory = arena.allocate( sizeof(T), alignof(T) );
+   return arena_ptr<T>( ::new (memory) T( std::forward<Ts>( params )... ) );
+}
+
+
+
+
 //---- <Main.cpp> ---------------------------------------------------------------------------------
 
+// Number of minor page faults of the process so far (or 0 if unavailable)
+long page_faults()
+{
+#if MAKEUNIQUE_HAS_RUSAGE
+   rusage usage{};
+   getrusage( RUSAGE_SELF, &usage );
+   return usage.ru_minflt;
+#else
+   return 0L;
+#endif
+}
+
+
+// Average time in milliseconds and average number of page faults for allocating a buffer of the
+// given size and for subsequently overwriting it
+template< typename Make >
+void benchmark_buffer( char const* name, Make make, size_t size, size_t repetitions, long& checksum )
+{
+   using Clock = std::chrono::steady_clock;
+   using Duration = std::chrono::duration<double,std::milli>;
+
+   Duration allocation{}, fill{};
+   long faults1{}, faults2{};
+
+   for( size_t rep=0U; rep<repetitions; ++rep )
+   {
+      long const f0 = page_faults();
+      auto const t0 = Clock::now();
+      auto buffer = make( size );
+      auto const t1 = Clock::now();
+      long const f1 = page_faults();
+      std::fill_n( buffer.get(), size, static_cast<unsigned char>( rep ) );
+      auto const t2 = Clock::now();
+      long const f2 = page_faults();
+
+      checksum += buffer[size/2U];
+      allocation += t1 - t0;
+      fill       += t2 - t1;
+      faults1    += f1 - f0;
+      faults2    += f2 - f1;
+   }
+
+   std::cout << std::fixed << std::setprecision(3)
+             << std::setw(36) << name
+             << std::setw(10) << allocation.count() / repetitions << " ms"
+             << std::setw(10) << fill.count() / repetitions << " ms"
+             << std::setw(13) << faults1 / static_cast<long>( repetitions )
+             << std::setw(13) << faults2 / static_cast<long>( repetitions ) << "\n";
+}
+
+
 int main()
 {
    // unique_ptr for a single Widget
@@ -267,5 +569,83 @@ int main()
       std::cout << " b has been moved to a (a=[" << a[0].get() << "," << a[1].get() << "," << a[2].get() << "])\n\n";
    }
 
+   // unique_ptr for a Widget living in an arena
+   {
+      Arena arena{};
+
+      auto a = make_arena_unique<Widget>( arena, 6 );
+      std::cout << " a has been created in the arena (a=" << a->get() << ")\n\n";
+
+      arena_ptr<const Widget> b( std::move( a ) );
+      std::cout << " a has been moved to b (b=" << b->get() << ")\n\n";
+   }
+
+   // Comparison of 'make_unique()' and 'make_arena_unique()' for many short-lived objects
+   {
+      using Clock = std::chrono::steady_clock;
+
+      constexpr size_t N( 1000000U );
+      long checksum{};
+
+      auto const start1 = Clock::now();
+      {
+         std::vector< unique_ptr<long> > v;
+         v.reserve( N );
+         for( size_t i=0U; i<N; ++i ) {
+            v.push_back( make_unique<long>( static_cast<long>( i ) ) );
+            checksum += *v.back();
+         }
+      }
+      std::chrono::duration<double,std::milli> const time1 = Clock::now() - start1;
+
+      auto const start2 = Clock::now();
+      {
+         Arena arena{};
+         std::vector< arena_ptr<long> > v;
+         v.reserve( N );
+         for( size_t i=0U; i<N; ++i ) {
+            v.push_back( make_arena_unique<long>( arena, static_cast<long>( i ) ) );
+            checksum += *v.back();
+         }
+      }
+      std::chrono::duration<double,std::milli> const time2 = Clock::now() - start2;
+
+      std::cout << " make_unique()      : " << time1.count() << " ms\n"
+                << " make_arena_unique(): " << time2.count() << " ms\n"
+                << " (checksum " << checksum << ")\n\n";
+   }
+
+   // Default-initialized and aligned buffers
+   {
+      auto a = make_unique_for_overwrite<int>();
+      *a = 7;
+      std::cout << " a has been created for overwrite (a=" << *a << ")\n\n";
+
+      auto b = make_aligned_unique_for_overwrite<float[],64U>( 16U );
+      std::cout << " b has been created with alignment 64 (address % 64 = "
+                << reinterpret_cast<std::uintptr_t>( b.get() ) % 64U << ")\n\n";
+   }
+
+   // Comparison of the allocation and fill cost of value-initialized and default-initialized
+   // I/O buffers (including the page faults of the allocation and of the fill)
+   {
+      constexpr size_t size( 64UL << 20 );
+      constexpr size_t repetitions( 10U );
+      long checksum{};
+
+      std::cout << " 64 MiB buffer                        allocation          fill"
+                   " alloc faults   fill faults\n";
+      benchmark_buffer( "make_unique<T[]>()"
+                      , []( size_t n ){ return make_unique<unsigned char[]>( n ); }
+                      , size, repetitions, checksum );
+      benchmark_buffer( "make_unique_for_overwrite<T[]>()"
+                      , []( size_t n ){ return make_unique_for_overwrite<unsigned char[]>( n ); }
+                      , size, repetitions, checksum );
+      benchmark_buffer( "make_aligned_unique_for_overwrite()"
+                      , []( size_t n ){ return make_aligned_unique_for_overwrite<unsigned char[]>( n ); }
+                      , size, repetitions, checksum );
+      std::cout << " (checksum " << checksum << ")\n\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -21,10 +21,27 @@
 *
 **************************************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <exception>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -54,6 +71,282 @@ void cartesian_product( Func func, Ranges const&... ranges )
 }
 
 
+// Lazy view on the cartesian product of the given random access ranges. Every element of the
+// product is identified by a linear index, which is decomposed into one index per range (the
+// last range varies fastest, as for 'cartesian_product()'). Thus the product can be partitioned,
+// resumed at an arbitrary position, or left early, and works with all 'std::ranges' algorithms.
+template< std::ranges::view... Views >
+   requires( sizeof...(Views) > 0U &&
+             ( ( std::ranges::random_access_range<Views const> &&
+                 std::ranges::sized_range<Views const> ) && ... ) )
+class cartesian_product_view
+   : public std::ranges::view_interface< cartesian_product_view<Views...> >
+{
+ private:
+   static constexpr size_t N = sizeof...(Views);
+
+ public:
+   class iterator
+   {
+    public:
+      using iterator_concept = std::random_access_iterator_tag;
+      using difference_type  = std::ptrdiff_t;
+
+      // The elements are tuples of references to the elements of the ranges. Since C++20 provides
+      // no common reference between a tuple of references and a tuple of values, the value type
+      // is the reference type as well.
+      using reference  = std::tuple< std::ranges::range_reference_t<Views const>... >;
+      using value_type = reference;
+
+      iterator() = default;
+
+      reference operator*() const
+      {
+         return std::apply( []( auto const&... its ){ return reference( *its... ); }, its_ );
+      }
+
+      reference operator[]( difference_type n ) const { return *( *this + n ); }
+
+      // Position of the iterator within the linear index space
+      difference_type index() const noexcept { return index_; }
+
+      iterator& operator++()
+      {
+         ++index_;
+         increment<N-1U>();
+         return *this;
+      }
+
+      iterator& operator--()
+      {
+         --index_;
+         decrement<N-1U>();
+         return *this;
+      }
+
+      iterator operator++( int ) { iterator tmp( *this ); ++*this; return tmp; }
+      iterator operator--( int ) { iterator tmp( *this ); --*this; return tmp; }
+
+      iterator& operator+=( difference_type n ) { decode( index_ + n ); return *this; }
+      iterator& operator-=( difference_type n ) { decode( index_ - n ); return *this; }
+
+      friend iterator operator+( iterator it, difference_type n ) { return it += n; }
+      friend iterator operator+( difference_type n, iterator it ) { return it += n; }
+      friend iterator operator-( iterator it, difference_type n ) { return it -= n; }
+
+      friend difference_type operator-( iterator const& lhs, iterator const& rhs ) noexcept
+      {
+         return lhs.index_ - rhs.index_;
+      }
+
+      friend bool operator==( iterator const& lhs, iterator const& rhs ) noexcept
+      {
+         return lhs.index_ == rhs.index_;
+      }
+
+      friend auto operator<=>( iterator const& lhs, iterator const& rhs ) noexcept
+      {
+         return lhs.index_ <=> rhs.index_;
+      }
+
+    private:
+      friend class cartesian_product_view;
+
+      using Iterators = std::tuple< std::ranges::iterator_t<Views const>... >;
+
+      iterator( cartesian_product_view const* parent, difference_type index )
+         : parent_( parent )
+         , sizes_( parent->sizes_ )
+      {
+         decode( index );
+      }
+
+      // Advances the per-range iterators like an odometer
+      template< size_t I >
+      void increment()
+      {
+         ++std::get<I>( its_ );
+         if constexpr( I > 0U ) {
+            if( ++pos_[I] < sizes_[I] ) return;
+            pos_[I] = 0;
+            std::get<I>( its_ ) -= sizes_[I];
+            increment<I-1U>();
+         }
+      }
+
+      template< size_t I >
+      void decrement()
+      {
+         if constexpr( I > 0U ) {
+            if( pos_[I] == 0 ) {
+               pos_[I] = sizes_[I];
+               std::get<I>( its_ ) += sizes_[I];
+               decrement<I-1U>();
+            }
+            --pos_[I];
+         }
+         --std::get<I>( its_ );
+      }
+
+      // Decomposes the linear index into one index per range
+      void decode( difference_type index )
+      {
+         index_ = index;
+         pos_ = {};
+
+         if( parent_->size() != 0U ) {
+            for( size_t i=N-1U; i>0U; --i ) {
+               pos_[i] = index % sizes_[i];
+               index  /= sizes_[i];
+            }
+            pos_[0] = index;
+         }
+
+         its_ = [&]<size_t... Is>( std::index_sequence<Is...> ) {
+            return Iterators( std::ranges::begin( std::get<Is>( parent_->views_ ) ) + pos_[Is]... );
+         }( std::make_index_sequence<N>{} );
+      }
+
+      cartesian_product_view const* parent_{};
+      difference_type index_{};
+      Iterators its_{};
+      std::array<difference_type,N> pos_{};    // Only the indices of the ranges 1 to N-1 are updated
+      std::array<difference_type,N> sizes_{};  // during increments and decrements
+   };
+
+   cartesian_product_view() = default;
+
+   explicit cartesian_product_view( Views... views )
+      : views_( std::move( views )... )
+   {
+      sizes_ = std::apply( []( auto const&... v ){
+         return std::array<std::ptrdiff_t,N>{ static_cast<std::ptrdiff_t>( std::ranges::size( v ) )... };
+      }, views_ );
+   }
+
+   iterator begin() const { return iterator( this, 0 ); }
+   iterator end()   const { return iterator( this, static_cast<std::ptrdiff_t>( size() ) ); }
+
+   size_t size() const noexcept
+   {
+      size_t product( 1U );
+      for( std::ptrdiff_t const size : sizes_ ) {
+         product *= static_cast<size_t>( size );
+      }
+      return product;
+   }
+
+ private:
+   std::tuple<Views...> views_{};
+   std::array<std::ptrdiff_t,N> sizes_{};
+};
+
+template< typename... Ranges >
+cartesian_product_view( Ranges&&... ) -> cartesian_product_view< std::views::all_t<Ranges>... >;
+
+
+// Execution policy for 'parallel_cartesian_product()'
+struct parallel_policy
+{
+   size_t threads{ std::max( std::thread::hardware_concurrency(), 1U ) };
+   size_t grain_size{ 65536U };   // Number of combinations per block
+   std::stop_token stop_token{};  // Optional cancellation from outside
+};
+
+// Calls 'func' for all combinations of the elements of the given ranges on up to 'policy.threads'
+// threads. The combined index space is split into contiguous blocks of 'policy.grain_size'
+// combinations, which the threads claim one after another. Per block, the first combination is
+// decoded once and all following combinations are reached incrementally. The processing is
+// cancelled (at block granularity) in case 'func' returns 'false', a stop is requested via
+// 'policy.stop_token', or 'func' throws, in which case the exception is rethrown. Returns whether
+// all combinations have been processed. Note that 'func' is called concurrently.
+template< typename Func, typename... Ranges >
+bool parallel_cartesian_product( parallel_policy const& policy, Func func, Ranges const&... ranges )
+{
+   using Result = std::invoke_result_t< Func&, std::ranges::range_reference_t<Ranges const>... >;
+
+   cartesian_product_view const view( ranges... );
+   size_t const size   = view.size();
+   size_t const grain  = std::max( policy.grain_size, size_t{ 1U } );
+   size_t const blocks = size / grain + ( size % grain != 0U );  // No overflow for large grains
+
+   std::atomic<size_t> next{ 0U };
+   std::atomic<bool> cancelled{ false };
+   std::exception_ptr exception{};
+   std::mutex mutex{};
+
+   auto const work = [&]
+   {
+      try {
+         for( size_t block=next++; block<blocks; block=next++ )
+         {
+            if( cancelled.load( std::memory_order_relaxed ) || policy.stop_token.stop_requested() ) {
+               cancelled = true;
+               return;
+            }
+
+            size_t const first = block * grain;
+            auto it = view.begin() + static_cast<std::ptrdiff_t>( first );
+
+            for( size_t n=std::min( grain, size-first ); n>0U; --n, ++it ) {
+               if constexpr( std::is_same_v<Result,bool> ) {
+                  if( !std::apply( func, *it ) ) {
+                     cancelled = true;
+                     return;
+                  }
+               }
+               else {
+                  std::apply( func, *it );
+               }
+            }
+         }
+      }
+      catch( ... ) {
+         std::scoped_lock const lock( mutex );
+         if( !exception ) exception = std::current_exception();
+         cancelled = true;
+      }
+   };
+
+   {
+      // The calling thread takes part in the processing
+      size_t const threads = std::min( std::max( policy.threads, size_t{ 1U } ), std::max( blocks, size_t{ 1U } ) );
+      std::vector<std::jthread> workers{};
+      workers.reserve( threads-1U );
+      for( size_t i=1U; i<threads; ++i ) {
+         workers.emplace_back( work );
+      }
+      work();
+   }
+
+   if( exception ) std::rethrow_exception( exception );
+   return !cancelled;
+}
+
+
+// Time in milliseconds to sum up all elements of the cartesian product of 'sizeof...(Is)'
+// ranges via the callback of 'cartesian_product()' and via 'cartesian_product_view'
+template< size_t... Is >
+std::pair<double,double> benchmark( std::vector<int> const& v, std::index_sequence<Is...>, long& sum )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start1 = Clock::now();
+   cartesian_product( [&]( auto const&... elements ){
+      sum += ( elements + ... );
+   }, ( (void)Is, v )... );
+   std::chrono::duration<double,std::milli> const time1 = Clock::now() - start1;
+
+   auto const start2 = Clock::now();
+   for( auto const& elements : cartesian_product_view( ( (void)Is, v )... ) ) {
+      sum += std::apply( []( auto const&... e ){ return ( e + ... ); }, elements );
+   }
+   std::chrono::duration<double,std::milli> const time2 = Clock::now() - start2;
+
+   return { time1.count(), time2.count() };
+}
+
+
 int main()
 {
    std::vector<int> v1{ 1, 2, 3 };
@@ -75,5 +368,123 @@ int main()
    //   std::cout << e1 << '-' << e2 << '-' << e3 << '\n';
    //}, v1, v2, v3 );
 
+   // Lazy cartesian product view
+   {
+      cartesian_product_view const view( v1, v2, v3 );
+
+      static_assert( std::ranges::random_access_range< decltype(view) > );
+      static_assert( std::ranges::sized_range< decltype(view) > );
+      static_assert( std::ranges::view< std::remove_const_t< decltype(view) > > );
+
+      assert( view.size() == 12U );
+      assert( view[7] == std::make_tuple( 2, 'b', "blue" ) );
+      assert( *( view.end() - 1 ) == std::make_tuple( 3, 'b', "blue" ) );
+
+      // Early exit via a standard algorithm
+      [[maybe_unused]] auto const pos = std::ranges::find_if( view, []( auto const& t ){ return std::get<1>( t ) == 'b'; } );
+      assert( pos.index() == 2 );
+
+      // Partitioning of the index space and resumption at an arbitrary position
+      std::cout << "\n Second half:";
+      for( auto const& [number, letter, color] : std::ranges::subrange( view.begin() + 6, view.end() ) ) {
+         std::cout << ' ' << number << '-' << letter << '-' << color;
+      }
+      std::cout << "\n Every 5th  :";
+      for( auto it=view.begin(); it<view.end(); it+=5 ) {
+         auto const& [number, letter, color] = *it;
+         std::cout << ' ' << number << '-' << letter << '-' << color;
+      }
+      std::cout << "\n\n";
+   }
+
+   // Comparison of 'cartesian_product()' and 'cartesian_product_view' for 2 to 6 ranges
+   {
+      constexpr double elements( 2E7 );
+      long sum{};
+
+      std::cout << " Ranges   Elements   cartesian_product()   cartesian_product_view\n";
+
+      auto const run = [&]<size_t K>( std::integral_constant<size_t,K> ) {
+         size_t const n = static_cast<size_t>( std::round( std::pow( elements, 1.0/K ) ) );
+         std::vector<int> v( n );
+         std::iota( v.begin(), v.end(), 0 );
+
+         auto const [t1, t2] = benchmark( v, std::make_index_sequence<K>{}, sum );
+         std::cout << std::setw(7) << K << std::setw(11) << static_cast<size_t>( std::pow( n, K ) )
+                   << std::setw(19) << t1 << " ms" << std::setw(22) << t2 << " ms\n";
+      };
+      run( std::integral_constant<size_t,2U>{} );
+      run( std::integral_constant<size_t,3U>{} );
+      run( std::integral_constant<size_t,4U>{} );
+      run( std::integral_constant<size_t,5U>{} );
+      run( std::integral_constant<size_t,6U>{} );
+
+      std::cout << " (checksum " << sum << ")\n\n";
+   }
+
+   // Parallel cartesian product with cancellation
+   {
+      std::atomic<int> count{};
+      [[maybe_unused]] bool const completed = parallel_cartesian_product( parallel_policy{ .grain_size = 4U },
+         [&]( int, char, std::string const& ){ ++count; }, v1, v2, v3 );
+      assert( completed && count == 12 );
+
+      // A single block for the entire index space
+      count = 0;
+      [[maybe_unused]] bool const single = parallel_cartesian_product( parallel_policy{ .grain_size = SIZE_MAX },
+         [&]( int, char, std::string const& ){ ++count; }, v1, v2, v3 );
+      assert( single && count == 12 );
+
+      std::atomic<int> visited{};
+      [[maybe_unused]] bool const found = !parallel_cartesian_product( parallel_policy{ .threads = 1U, .grain_size = 4U },
+         [&]( int number, char letter, std::string const& ){ ++visited; return !( number == 2 && letter == 'b' ); },
+         v1, v2, v3 );
+      assert( found && visited == 7 );
+
+      std::stop_source source{};
+      source.request_stop();
+      assert( !parallel_cartesian_product( parallel_policy{ .stop_token = source.get_token() },
+                                           []( int, char ){}, v1, v2 ) );
+
+      std::cout << " Parallel product: " << count << " combinations, stopped after " << visited << "\n\n";
+   }
+
+   // Strong scaling of 'parallel_cartesian_product()' for a fixed sweep over five ranges
+   {
+      std::vector<int> v( 36U );
+      std::iota( v.begin(), v.end(), 0 );
+
+      using Clock = std::chrono::steady_clock;
+
+      auto const sweep = [&]( size_t threads, size_t grain_size ) {
+         std::atomic<long> hits{};
+         auto const start = Clock::now();
+         parallel_cartesian_product( parallel_policy{ .threads = threads, .grain_size = grain_size },
+            [&]( int a, int b, int c, int d, int e ) {
+               if( ( a*b + c*d*e ) % 4099 == 0 ) hits.fetch_add( 1, std::memory_order_relaxed );
+            }, v, v, v, v, v );
+         std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+         return std::make_pair( time.count(), hits.load() );
+      };
+
+      size_t const hardware = std::max( std::thread::hardware_concurrency(), 1U );
+      auto const [serial, hits] = sweep( 1U, 65536U );
+
+      std::cout << " Threads        Time   Speedup   Efficiency  (" << hardware << " hardware threads, "
+                << hits << " hits)\n";
+      for( size_t threads=1U; threads<=std::max( hardware, size_t{ 4U } ); threads*=2U ) {
+         double const time = sweep( threads, 65536U ).first;
+         std::cout << std::setw(8) << threads << std::setw(9) << time << " ms"
+                   << std::setw(10) << serial/time
+                   << std::setw(12) << serial/time/threads << "\n";
+      }
+
+      std::cout << "\n Grain size      Time\n";
+      for( size_t const grain : { 64U, 4096U, 65536U, 1048576U } ) {
+         std::cout << std::setw(11) << grain << std::setw(10) << sweep( hardware, grain ).first << " ms\n";
+      }
+      std::cout << "\n";
+   }
+
    return EXIT_SUCCESS;
 }
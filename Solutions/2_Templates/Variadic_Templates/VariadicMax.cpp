@@ -16,10 +16,22 @@
 **************************************************************************************************/
 
 #include <array>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 
 //== max() for 1 or more parameter ================================================================
@@ -169,19 +181,423 @@ constexpr auto max( T1 const& a, T2 const& b, Ts const&... args )
 
 // Application of the 'max()' function template to determine the largest given type
 template< typename T, typename... Ts >
-struct Variant
+class Variant;
+
+
+namespace detail {
+
+template< typename T, typename... Ts >
+std::true_type is_variant( const volatile Variant<T,Ts...>* );
+
+std::false_type is_variant( ... );
+
+// Number of occurrences of the type 'U' within the types 'Ts'
+template< typename U, typename... Ts >
+constexpr size_t type_count = ( size_t{ std::is_same_v<U,Ts> } + ... + 0U );
+
+// Index of the type 'U' within the types 'Ts' (or 'sizeof...(Ts)' if 'U' is not contained)
+template< typename U, typename... Ts >
+constexpr size_t type_index()
 {
- public:
-   // ...
+   constexpr bool matches[] = { std::is_same_v<U,Ts>..., false };
+   size_t index{};
+   while( index < sizeof...(Ts) && !matches[index] ) ++index;
+   return index;
+}
+
+// Overload set for the selection of the alternative of a converting construction: As for
+// 'std::variant' (P0608, P1957), the alternative is chosen by overload resolution among all
+// alternatives 'T' that can be initialized via 'T x[] = { std::declval<U>() };', i.e. without
+// a narrowing conversion. In addition, pointers are never converted to 'bool'.
+template< typename U, size_t I, typename T >
+struct Alternative
+{
+   static std::integral_constant<size_t,I> select( T )
+      requires( requires { std::type_identity_t<T[]>{ std::declval<U>() }; } &&
+                !( std::is_same_v< std::remove_cv_t<T>, bool > &&
+                   ( std::is_pointer_v< std::decay_t<U> > || std::is_member_pointer_v< std::decay_t<U> > ) ) );
+};
+
+template< typename U, typename Indices, typename... Ts >
+struct Selector;
+
+template< typename U, size_t... Is, typename... Ts >
+struct Selector< U, std::index_sequence<Is...>, Ts... >
+   : public Alternative<U,Is,Ts>...
+{
+   using Alternative<U,Is,Ts>::select...;
+};
+
+template< typename U, typename... Ts >
+using selected_index =
+   decltype( Selector< U, std::index_sequence_for<Ts...>, Ts... >::select( std::declval<U>() ) );
 
+// Type 'A' with the const and reference qualification of 'V'
+template< typename V, typename A >
+using forward_like_t =
+   std::conditional_t< std::is_lvalue_reference_v<V>
+                     , std::conditional_t< std::is_const_v< std::remove_reference_t<V> >, A const&, A& >
+                     , std::conditional_t< std::is_const_v< std::remove_reference_t<V> >, A const&&, A&& > >;
+
+} // namespace detail
+
+template< typename V >
+inline constexpr bool is_variant_v = decltype( detail::is_variant( std::declval<V*>() ) )::value;
+
+
+// Type-safe union of the types 'T' and 'Ts...'. The alternatives are stored in a raw buffer, whose
+// size and alignment is determined by 'max()', and the active alternative is identified by the
+// smallest possible index type (i.e. 'uint8_t' for up to 255 alternatives). In case the
+// construction of a new alternative throws, the variant becomes valueless.
+template< typename T, typename... Ts >
+class Variant
+{
+ public:
    static constexpr size_t capacity  = max( sizeof(T), sizeof(Ts)... );
    static constexpr size_t alignment = max( alignof(T), alignof(Ts)... );
+   static constexpr size_t size      = 1U + sizeof...(Ts);
+
+   // One more value than alternatives is required for the valueless state
+   using index_type = std::conditional_t< ( size <= 0xFFU ), std::uint8_t,
+                      std::conditional_t< ( size <= 0xFFFFU ), std::uint16_t, std::uint32_t > >;
+
+   template< size_t I >
+   using alternative_t = std::tuple_element_t< I, std::tuple<T,Ts...> >;
+
+   template< typename U >
+   static constexpr size_t index_of = detail::type_index<U,T,Ts...>();
+
+   template< typename U >
+   static constexpr size_t count_of = detail::type_count<U,T,Ts...>;
+
+ private:
+   static constexpr index_type npos = static_cast<index_type>( -1 );
+
+   // As for 'std::variant', the special members are only available if all alternatives support
+   // the according operation; assignment additionally requires the according construction
+   static constexpr bool copy_constructible =
+      std::is_copy_constructible_v<T> && ( std::is_copy_constructible_v<Ts> && ... );
+   static constexpr bool move_constructible =
+      std::is_move_constructible_v<T> && ( std::is_move_constructible_v<Ts> && ... );
+   static constexpr bool copy_assignable =
+      copy_constructible &&
+      std::is_copy_assignable_v<T> && ( std::is_copy_assignable_v<Ts> && ... );
+   static constexpr bool move_assignable =
+      move_constructible &&
+      std::is_move_assignable_v<T> && ( std::is_move_assignable_v<Ts> && ... );
+
+   static constexpr bool trivially_copy_constructible =
+      std::is_trivially_copy_constructible_v<T> && ( std::is_trivially_copy_constructible_v<Ts> && ... );
+   static constexpr bool trivially_move_constructible =
+      std::is_trivially_move_constructible_v<T> && ( std::is_trivially_move_constructible_v<Ts> && ... );
+   static constexpr bool trivially_copy_assignable =
+      trivially_copy_constructible &&
+      std::is_trivially_copy_assignable_v<T> && ( std::is_trivially_copy_assignable_v<Ts> && ... );
+   static constexpr bool trivially_move_assignable =
+      trivially_move_constructible &&
+      std::is_trivially_move_assignable_v<T> && ( std::is_trivially_move_assignable_v<Ts> && ... );
+   static constexpr bool trivially_destructible =
+      std::is_trivially_destructible_v<T> && ( std::is_trivially_destructible_v<Ts> && ... );
+
+ public:
+   Variant() noexcept( std::is_nothrow_default_constructible_v<T> )
+      requires( std::is_default_constructible_v<T> )
+   {
+      construct<0U>();
+   }
+
+   template< typename U >
+   Variant( U&& value )
+      requires( !std::is_same_v< std::remove_cvref_t<U>, Variant > &&
+                requires { detail::selected_index<U,T,Ts...>::value; } )
+   {
+      construct< detail::selected_index<U,T,Ts...>::value >( std::forward<U>( value ) );
+   }
+
+   template< size_t I, typename... Args >
+   explicit Variant( std::in_place_index_t<I>, Args&&... args )
+   {
+      construct<I>( std::forward<Args>( args )... );
+   }
+
+   template< typename U, typename... Args >
+   explicit Variant( std::in_place_type_t<U>, Args&&... args )
+      requires( detail::type_count<U,T,Ts...> == 1U )
+   {
+      construct< detail::type_index<U,T,Ts...>() >( std::forward<Args>( args )... );
+   }
+
+   Variant( Variant const& ) requires( trivially_copy_constructible ) = default;
+   Variant( Variant const& other )
+      requires( copy_constructible && !trivially_copy_constructible )
+   {
+      other.dispatch( [&]( auto i ){ construct<i>( other.template ref<i>() ); } );
+   }
+
+   Variant( Variant&& ) requires( trivially_move_constructible ) = default;
+   Variant( Variant&& other )
+      noexcept( std::is_nothrow_move_constructible_v<T> && ( std::is_nothrow_move_constructible_v<Ts> && ... ) )
+      requires( move_constructible && !trivially_move_constructible )
+   {
+      other.dispatch( [&]( auto i ){ construct<i>( std::move( other.template ref<i>() ) ); } );
+   }
+
+   ~Variant() = default;
+   ~Variant() requires( !trivially_destructible )
+   {
+      reset();
+   }
+
+   Variant& operator=( Variant const& ) requires( trivially_copy_assignable ) = default;
+   Variant& operator=( Variant const& other )
+      requires( copy_assignable && !trivially_copy_assignable )
+   {
+      if( this == &other ) return *this;
+
+      if( index_ == other.index_ ) {
+         other.dispatch( [&]( auto i ){ ref<i>() = other.template ref<i>(); } );
+      }
+      else {
+         reset();
+         other.dispatch( [&]( auto i ){ construct<i>( other.template ref<i>() ); } );
+      }
+      return *this;
+   }
+
+   Variant& operator=( Variant&& ) requires( trivially_move_assignable ) = default;
+   Variant& operator=( Variant&& other )
+      requires( move_assignable && !trivially_move_assignable )
+   {
+      if( this == &other ) return *this;
+
+      if( index_ == other.index_ ) {
+         other.dispatch( [&]( auto i ){ ref<i>() = std::move( other.template ref<i>() ); } );
+      }
+      else {
+         reset();
+         other.dispatch( [&]( auto i ){ construct<i>( std::move( other.template ref<i>() ) ); } );
+      }
+      return *this;
+   }
+
+   template< typename U >
+   Variant& operator=( U&& value )
+      requires( !std::is_same_v< std::remove_cvref_t<U>, Variant > &&
+                requires { detail::selected_index<U,T,Ts...>::value; } )
+   {
+      constexpr size_t I( detail::selected_index<U,T,Ts...>::value );
+
+      if( index_ == I ) ref<I>() = std::forward<U>( value );
+      else              emplace<I>( std::forward<U>( value ) );
+      return *this;
+   }
+
+   size_t index() const noexcept { return index_ == npos ? std::variant_npos : index_; }
+   bool valueless_by_exception() const noexcept { return index_ == npos; }
+
+   template< size_t I, typename... Args >
+   alternative_t<I>& emplace( Args&&... args )
+   {
+      reset();
+      construct<I>( std::forward<Args>( args )... );
+      return ref<I>();
+   }
+
+   template< typename U, typename... Args >
+   U& emplace( Args&&... args )
+      requires( detail::type_count<U,T,Ts...> == 1U )
+   {
+      return emplace< detail::type_index<U,T,Ts...>() >( std::forward<Args>( args )... );
+   }
+
+   template< size_t I >
+   alternative_t<I>* get_if() noexcept { return index_ == I ? &ref<I>() : nullptr; }
+
+   template< size_t I >
+   alternative_t<I> const* get_if() const noexcept { return index_ == I ? &ref<I>() : nullptr; }
 
  private:
+   template< size_t I >
+   alternative_t<I>& ref() noexcept
+   {
+      return *std::launder( reinterpret_cast<alternative_t<I>*>( buffer_.data() ) );
+   }
+
+   template< size_t I >
+   alternative_t<I> const& ref() const noexcept
+   {
+      return *std::launder( reinterpret_cast<alternative_t<I> const*>( buffer_.data() ) );
+   }
+
+   template< size_t I, typename... Args >
+   void construct( Args&&... args )
+   {
+      ::new( buffer_.data() ) alternative_t<I>( std::forward<Args>( args )... );
+      index_ = static_cast<index_type>( I );
+   }
+
+   void reset() noexcept
+   {
+      if constexpr( !trivially_destructible ) {
+         dispatch( [&]( auto i ){ std::destroy_at( &ref<i>() ); } );
+      }
+      index_ = npos;
+   }
+
+   // Calls 'f' with the index of the active alternative as 'std::integral_constant'
+   template< typename F >
+   void dispatch( F&& f ) const
+   {
+      [&]<size_t... Is>( std::index_sequence<Is...> ) {
+         ( void )( ( index_ == Is && ( f( std::integral_constant<size_t,Is>{} ), true ) ) || ... );
+      }( std::make_index_sequence<size>{} );
+   }
+
    alignas(alignment) std::array<std::byte,capacity> buffer_;
+   index_type index_{ npos };
 };
 
 
+template< size_t I, typename V >
+   requires( is_variant_v< std::remove_cvref_t<V> > )
+decltype(auto) get( V&& v ) noexcept
+{
+   using A = typename std::remove_cvref_t<V>::template alternative_t<I>;
+
+   assert( v.index() == I );
+   return static_cast< detail::forward_like_t<V,A> >( *v.template get_if<I>() );
+}
+
+template< typename U, typename V >
+   requires( is_variant_v< std::remove_cvref_t<V> > &&
+             std::remove_cvref_t<V>::template count_of<U> == 1U )
+decltype(auto) get( V&& v ) noexcept
+{
+   return ::get< std::remove_cvref_t<V>::template index_of<U> >( std::forward<V>( v ) );
+}
+
+template< typename U, typename T, typename... Ts >
+bool holds_alternative( Variant<T,Ts...> const& v ) noexcept
+{
+   return v.index() == Variant<T,Ts...>::template index_of<U>;
+}
+
+template< typename T, typename... Ts >
+bool operator==( Variant<T,Ts...> const& lhs, Variant<T,Ts...> const& rhs )
+{
+   if( lhs.index() != rhs.index() ) return false;
+   if( lhs.valueless_by_exception() ) return true;
+
+   return [&]<size_t... Is>( std::index_sequence<Is...> ) {
+      return ( ( lhs.index() == Is && *lhs.template get_if<Is>() == *rhs.template get_if<Is>() ) || ... );
+   }( std::make_index_sequence< Variant<T,Ts...>::size >{} );
+}
+
+
+namespace detail {
+
+template< typename R, size_t I, typename F, typename V >
+R visit_alternative( F&& f, V&& v )
+{
+   static_assert( std::is_same_v< R, std::invoke_result_t< F, decltype( ::get<I>( std::declval<V>() ) ) > >,
+                  "The visitor must return the same type for all alternatives" );
+
+   return std::invoke( std::forward<F>( f ), ::get<I>( std::forward<V>( v ) ) );
+}
+
+// Dispatch via a chain of index comparisons, which the compiler can turn into a jump table
+// without giving up on the inlining of the visitor
+template< typename R, size_t I, typename F, typename V >
+R visit_switch( size_t index, F&& f, V&& v )
+{
+   if constexpr( I+1U == std::remove_cvref_t<V>::size ) {
+      return visit_alternative<R,I>( std::forward<F>( f ), std::forward<V>( v ) );
+   }
+   else {
+      if( index == I ) return visit_alternative<R,I>( std::forward<F>( f ), std::forward<V>( v ) );
+      return visit_switch<R,I+1U>( index, std::forward<F>( f ), std::forward<V>( v ) );
+   }
+}
+
+// Dispatch via a constexpr table of function pointers with one entry per alternative
+template< typename R, typename F, typename V >
+R visit_table( size_t index, F&& f, V&& v )
+{
+   static constexpr auto table = []<size_t... Is>( std::index_sequence<Is...> ) {
+      return std::array{ &visit_alternative<R,Is,F,V>... };
+   }( std::make_index_sequence< std::remove_cvref_t<V>::size >{} );
+
+   return table[index]( std::forward<F>( f ), std::forward<V>( v ) );
+}
+
+} // namespace detail
+
+
+// Calls 'f' with the active alternative of 'v'. Small variants are dispatched via a chain of
+// comparisons, large variants via a table of function pointers.
+template< typename F, typename V >
+   requires( is_variant_v< std::remove_cvref_t<V> > )
+decltype(auto) visit( F&& f, V&& v )
+{
+   using R = std::invoke_result_t< F, decltype( ::get<0U>( std::declval<V>() ) ) >;
+
+   assert( !v.valueless_by_exception() );
+
+   if constexpr( std::remove_cvref_t<V>::size <= 16U )
+      return detail::visit_switch<R,0U>( v.index(), std::forward<F>( f ), std::forward<V>( v ) );
+   else
+      return detail::visit_table<R>( v.index(), std::forward<F>( f ), std::forward<V>( v ) );
+}
+
+
+// Variant with 'N' distinct empty alternatives
+template< size_t I >
+struct Tag {};
+
+template< typename Indices >
+struct TagVariant;
+
+template< size_t... Is >
+struct TagVariant< std::index_sequence<Is...> >
+{
+   using type = Variant< Tag<Is>... >;
+};
+
+template< size_t N >
+using TagVariant_t = typename TagVariant< std::make_index_sequence<N> >::type;
+
+
+// Visitor summing up all alternatives of the benchmark variants
+struct Accumulator
+{
+   double operator()( int i )          const noexcept { return i; }
+   double operator()( double d )       const noexcept { return d; }
+   double operator()( float f )        const noexcept { return f; }
+   double operator()( long l )         const noexcept { return static_cast<double>( l ); }
+   double operator()( short s )        const noexcept { return s; }
+   double operator()( unsigned u )     const noexcept { return u; }
+   double operator()( char c )         const noexcept { return c; }
+   double operator()( std::string const& s ) const noexcept { return static_cast<double>( s.size() ); }
+};
+
+// Time in nanoseconds per visit of the given variants
+template< typename Variants, typename Visit >
+double benchmark( Variants const& variants, Visit visit, size_t repetitions, double& sum )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   for( size_t rep=0U; rep<repetitions; ++rep ) {
+      for( auto const& v : variants ) {
+         sum += visit( v );
+      }
+   }
+   std::chrono::duration<double,std::nano> const time = Clock::now() - start;
+
+   return time.count() / ( repetitions * variants.size() );
+}
+
+
 int main()
 {
    std::cout << "\n"
@@ -202,5 +618,109 @@ int main()
                 " v.alignment = " << v.alignment << "\n"
                 "\n";
 
+   // Construction, assignment and access
+   {
+      using V = Variant<int,double,std::string>;
+
+      static_assert( std::is_same_v< V::index_type, std::uint8_t > );
+      static_assert( std::is_same_v< TagVariant_t<255U>::index_type, std::uint8_t > );
+      static_assert( std::is_same_v< TagVariant_t<256U>::index_type, std::uint16_t > );
+      static_assert( std::is_trivially_copy_constructible_v< Variant<int,double> > );
+      static_assert( std::is_trivially_destructible_v< Variant<int,double> > );
+      static_assert( !std::is_trivially_destructible_v< V > );
+      static_assert( !std::is_copy_constructible_v< Variant<std::unique_ptr<int>,int> > );
+      static_assert( !std::is_copy_assignable_v< Variant<std::unique_ptr<int>,int> > );
+      static_assert( std::is_move_constructible_v< Variant<std::unique_ptr<int>,int> > );
+
+      V v1{ 42 };
+      V v2{ std::string( "variant" ) };
+      V v3{ std::in_place_type<double>, 3.14 };
+
+      assert( v1.index() == 0U && ::get<int>( v1 ) == 42 );
+      assert( holds_alternative<std::string>( v2 ) && ::get<2U>( v2 ) == "variant" );
+      assert( v3.get_if<1U>() != nullptr && v3.get_if<0U>() == nullptr );
+
+      v1 = v2;
+      assert( v1 == v2 );
+      v2 = 1.5;
+      assert( holds_alternative<double>( v2 ) );
+
+      V v4{ std::move( v1 ) };
+      assert( ::get<std::string>( v4 ) == "variant" );
+
+      std::string const s = ::get<std::string>( std::move( v4 ) );
+      assert( s == "variant" );
+
+      // No narrowing and no pointer to bool conversions in the selection of the alternative
+      using B = Variant<bool,std::string>;
+      static_assert( !std::is_constructible_v< Variant<int,char>, double > );
+      static_assert( std::is_constructible_v< Variant<long,float>, int > );
+      static_assert( !std::is_constructible_v< B, int* > );
+      assert( B{ "abc" }.index() == 1U && B{ true }.index() == 0U );
+
+      v4.emplace<int>( 7 );
+
+      TagVariant_t<40U> large{ Tag<33U>{} };
+      assert( ::visit( []<size_t I>( Tag<I> ){ return I; }, large ) == 33U );
+      auto const print = []( auto const& value ){ std::cout << " " << value; };
+      std::cout << " Variants:";
+      ::visit( print, v2 );
+      ::visit( print, v3 );
+      ::visit( print, v4 );
+      std::cout << "\n\n";
+   }
+
+   // Comparison of the object size of 'Variant' and 'std::variant'
+   {
+      std::cout << " Alternatives                   Variant   std::variant\n"
+                << " <char,short>            " << std::setw(14) << sizeof( Variant<char,short> )
+                << std::setw(15) << sizeof( std::variant<char,short> ) << "\n"
+                << " <int,float>             " << std::setw(14) << sizeof( Variant<int,float> )
+                << std::setw(15) << sizeof( std::variant<int,float> ) << "\n"
+                << " <int,double,std::string>" << std::setw(14) << sizeof( Variant<int,double,std::string> )
+                << std::setw(15) << sizeof( std::variant<int,double,std::string> ) << "\n\n";
+   }
+
+   // Comparison of the visit throughput of 'Variant' and 'std::variant'
+   {
+      constexpr size_t N( 100000U );
+      constexpr size_t repetitions( 100U );
+
+      using V1 = Variant<int,double,float,long,short,unsigned,char,std::string>;
+      using V2 = std::variant<int,double,float,long,short,unsigned,char,std::string>;
+
+      std::vector<V1> v1{};
+      std::vector<V2> v2{};
+      v1.reserve( N );
+      v2.reserve( N );
+
+      unsigned random{ 42U };
+      for( size_t i=0U; i<N; ++i ) {
+         random = random * 1103515245U + 12345U;
+         switch( ( random >> 16 ) % 8U ) {
+            case 0U: v1.emplace_back( 1 );                  v2.emplace_back( 1 );                  break;
+            case 1U: v1.emplace_back( 2.0 );                v2.emplace_back( 2.0 );                break;
+            case 2U: v1.emplace_back( 3.0F );               v2.emplace_back( 3.0F );               break;
+            case 3U: v1.emplace_back( 4L );                 v2.emplace_back( 4L );                 break;
+            case 4U: v1.emplace_back( short{ 5 } );         v2.emplace_back( short{ 5 } );         break;
+            case 5U: v1.emplace_back( 6U );                 v2.emplace_back( 6U );                 break;
+            case 6U: v1.emplace_back( char{ 7 } );          v2.emplace_back( char{ 7 } );          break;
+            default: v1.emplace_back( std::string( "8" ) ); v2.emplace_back( std::string( "8" ) ); break;
+         }
+      }
+
+      double sum{};
+      double const t1 = benchmark( v2, []( V2 const& v ){ return std::visit( Accumulator{}, v ); }, repetitions, sum );
+      double const t2 = benchmark( v1, []( V1 const& v ){
+         return detail::visit_switch<double,0U>( v.index(), Accumulator{}, v ); }, repetitions, sum );
+      double const t3 = benchmark( v1, []( V1 const& v ){
+         return detail::visit_table<double>( v.index(), Accumulator{}, v ); }, repetitions, sum );
+
+      std::cout << " std::visit           : " << std::setw(8) << t1 << " ns/visit\n"
+                << " visit (comparisons)  : " << std::setw(8) << t2 << " ns/visit\n"
+                << " visit (pointer table): " << std::setw(8) << t3 << " ns/visit\n"
+                << " (checksum " << sum << ")\n\n";
+   }
+
    return EXIT_SUCCESS;
 }
@@ -15,10 +15,19 @@
 *
 **************************************************************************************************/
 
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <iomanip>
+#include <iostream>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 
 template< typename T, typename... Ts >
@@ -61,6 +70,178 @@ template< typename V, typename T >
 constexpr size_t variant_index_v = variant_index<V,T>::value;
 
 
+// Container for the alternatives 'Ts...', which stores every alternative in a separate contiguous
+// array (lane). The lane of a type is given by its 'variant_index' within 'std::variant<Ts...>'.
+// In contrast to a 'std::vector<std::variant<Ts...>>', no element is padded to the largest
+// alternative and 'for_each_visit()' processes one type at a time without any per-element
+// dispatch. Optionally, the container keeps an order index to restore the insertion order.
+template< typename... Ts >
+class variant_vector
+{
+ public:
+   using variant_type = std::variant<Ts...>;
+
+   enum class Order { unordered, preserved };
+
+   explicit variant_vector( Order order = Order::unordered )
+      : order_( order )
+   {}
+
+   // Index of the lane of the alternative 'U'
+   template< typename U >
+   static constexpr size_t lane_index()
+   {
+      constexpr size_t index = variant_index_v< variant_type, U >;
+      static_assert( index != std::variant_npos, "Type is not an alternative of the variant_vector" );
+      return index;
+   }
+
+   size_t size() const noexcept { return ( std::get< std::vector<Ts> >( lanes_ ).size() + ... ); }
+   bool empty() const noexcept { return size() == 0U; }
+   bool is_ordered() const noexcept { return order_ == Order::preserved; }
+
+   template< typename U > std::vector<U>&       lane()       noexcept { return std::get<lane_index<U>()>( lanes_ ); }
+   template< typename U > std::vector<U> const& lane() const noexcept { return std::get<lane_index<U>()>( lanes_ ); }
+
+   // Reserves space for 'n' elements of the alternative 'U'
+   template< typename U >
+   void reserve( size_t n )
+   {
+      lane<U>().reserve( n );
+   }
+
+   template< typename U >
+   void push_back( U&& value )
+      requires( !std::is_same_v< std::remove_cvref_t<U>, variant_type > )
+   {
+      emplace_back< std::remove_cvref_t<U> >( std::forward<U>( value ) );
+   }
+
+   void push_back( variant_type const& v )
+   {
+      std::visit( [this]( auto const& value ){ push_back( value ); }, v );
+   }
+
+   template< typename U, typename... Args >
+   U& emplace_back( Args&&... args )
+   {
+      constexpr size_t index = lane_index<U>();
+      std::vector<U>& values = lane<U>();
+
+      if( is_ordered() ) {
+         order_index_.push_back( Entry{ static_cast<std::uint32_t>( values.size() ), static_cast<std::uint32_t>( index ) } );
+      }
+
+      try {
+         return values.emplace_back( std::forward<Args>( args )... );
+      }
+      catch( ... ) {
+         if( is_ordered() ) order_index_.pop_back();
+         throw;
+      }
+   }
+
+   void clear() noexcept
+   {
+      ( std::get< std::vector<Ts> >( lanes_ ).clear(), ... );
+      order_index_.clear();
+   }
+
+   // Calls 'f' for all elements, lane by lane
+   template< typename F >
+   void for_each_visit( F&& f )
+   {
+      ( for_each_in_lane( std::get< std::vector<Ts> >( lanes_ ), f ), ... );
+   }
+
+   template< typename F >
+   void for_each_visit( F&& f ) const
+   {
+      ( for_each_in_lane( std::get< std::vector<Ts> >( lanes_ ), f ), ... );
+   }
+
+   // Calls 'f' for all elements in insertion order; requires the order to be preserved
+   template< typename F >
+   void for_each_ordered( F&& f ) const
+   {
+      assert( is_ordered() );
+
+      for( Entry const& entry : order_index_ ) {
+         visit_at( entry, f );
+      }
+   }
+
+ private:
+   // Position of an element within its lane (limited to 2^32 elements per lane)
+   struct Entry
+   {
+      std::uint32_t offset;
+      std::uint32_t lane;
+   };
+
+   template< typename U, typename F >
+   static void for_each_in_lane( std::vector<U> const& values, F& f )
+   {
+      for( U const& value : values ) {
+         f( value );
+      }
+   }
+
+   template< typename U, typename F >
+   static void for_each_in_lane( std::vector<U>& values, F& f )
+   {
+      for( U& value : values ) {
+         f( value );
+      }
+   }
+
+   template< typename F >
+   void visit_at( Entry const& entry, F& f ) const
+   {
+      [&]<size_t... Is>( std::index_sequence<Is...> ) {
+         ( void )( ( entry.lane == Is && ( f( std::get<Is>( lanes_ )[entry.offset] ), true ) ) || ... );
+      }( std::index_sequence_for<Ts...>{} );
+   }
+
+   std::tuple< std::vector<Ts>... > lanes_{};
+   std::vector<Entry> order_index_{};
+   Order order_;
+};
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+struct Circle   { double radius; };
+struct Square   { double side; };
+struct Triangle { double x1, y1, x2, y2, x3, y3; };
+
+struct Area
+{
+   double operator()( Circle const& c ) const noexcept { return 3.14159265358979 * c.radius * c.radius; }
+   double operator()( Square const& s ) const noexcept { return s.side * s.side; }
+   double operator()( Triangle const& t ) const noexcept
+   {
+      return 0.5 * std::abs( t.x1*(t.y2-t.y3) + t.x2*(t.y3-t.y1) + t.x3*(t.y1-t.y2) );
+   }
+};
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+// Time in milliseconds for a single call of the given operation
+template< typename Operation >
+double measure( Operation op )
+{
+   using Clock = std::chrono::steady_clock;
+
+   auto const start = Clock::now();
+   op();
+   std::chrono::duration<double,std::milli> const time = Clock::now() - start;
+
+   return time.count();
+}
+
+
 int main()
 {
    using Variant = std::variant<int,double,std::string>;
@@ -70,5 +251,81 @@ int main()
    static_assert( variant_index_v<Variant,std::string> == 2UL );
    static_assert( variant_index_v<Variant,float>       == std::variant_npos );
 
+   // Type-segregated storage with and without insertion order
+   {
+      variant_vector<int,double,std::string> v( variant_vector<int,double,std::string>::Order::preserved );
+      v.push_back( 1 );
+      v.push_back( std::string( "two" ) );
+      v.push_back( 3.0 );
+      v.push_back( Variant{ 4 } );
+
+      static_assert( decltype(v)::lane_index<std::string>() == 2U );
+      assert( v.size() == 4U && v.lane<int>().size() == 2U );
+
+      std::cout << "\n Lanes    :";
+      v.for_each_visit( []( auto const& value ){ std::cout << " " << value; } );
+      std::cout << "\n Inserted :";
+      v.for_each_ordered( []( auto const& value ){ std::cout << " " << value; } );
+      std::cout << "\n\n";
+   }
+
+   // Comparison of a vector of variants and a variant_vector
+   {
+      constexpr size_t N( 3000000U );
+      constexpr size_t repetitions( 10U );
+
+      using Shape = std::variant<Circle,Square,Triangle>;
+
+      std::vector<Shape> v1{};
+      variant_vector<Circle,Square,Triangle> v2{};
+      variant_vector<Circle,Square,Triangle> v3( variant_vector<Circle,Square,Triangle>::Order::preserved );
+      v1.reserve( N );
+
+      unsigned random{ 42U };
+      for( size_t i=0U; i<N; ++i ) {
+         random = random * 1103515245U + 12345U;
+         double const x( static_cast<double>( i % 10U ) );
+         switch( ( random >> 16 ) % 4U ) {
+            case 0U: v1.emplace_back( Circle{ x } ); break;
+            case 1U: v1.emplace_back( Square{ x } ); break;
+            default: v1.emplace_back( Triangle{ 0.0, 0.0, x, 0.0, 0.0, x } ); break;
+         }
+         v2.push_back( v1.back() );
+         v3.push_back( v1.back() );
+      }
+
+      double sum1{}, sum2{}, sum3{};
+      Area const area{};
+
+      double const t1 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            for( Shape const& shape : v1 )
+               sum1 += std::visit( area, shape );
+      } ) / repetitions;
+      double const t2 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            v2.for_each_visit( [&]( auto const& shape ){ sum2 += area( shape ); } );
+      } ) / repetitions;
+      double const t3 = measure( [&]{
+         for( size_t rep=0U; rep<repetitions; ++rep )
+            v3.for_each_ordered( [&]( auto const& shape ){ sum3 += area( shape ); } );
+      } ) / repetitions;
+
+      size_t const bytes1 = N * sizeof(Shape);
+      size_t const bytes2 = v2.lane<Circle>().size() * sizeof(Circle) +
+                            v2.lane<Square>().size() * sizeof(Square) +
+                            v2.lane<Triangle>().size() * sizeof(Triangle);
+      size_t const bytes3 = bytes2 + N * 8U;  // Order index with 8 bytes per element
+
+      std::cout << "                                            MiB     Time\n"
+                << " std::vector<std::variant>          " << std::setw(9) << bytes1/(1U<<20)
+                << std::setw(9) << t1 << " ms\n"
+                << " variant_vector (for_each_visit)    " << std::setw(9) << bytes2/(1U<<20)
+                << std::setw(9) << t2 << " ms\n"
+                << " variant_vector (for_each_ordered)  " << std::setw(9) << bytes3/(1U<<20)
+                << std::setw(9) << t3 << " ms\n"
+                << " (checksum " << sum1 << " " << sum2 << " " << sum3 << ")\n\n";
+   }
+
    return EXIT_SUCCESS;
 }